@@ -0,0 +1,38 @@
+#include "BackgroundTask.h"
+
+BackgroundTask::BackgroundTask(const char* name, std::function<void(void)> fn, uint32_t stackSize) : _fn(fn)
+{
+    _done = xSemaphoreCreateBinary();
+    if (xTaskCreate(&BackgroundTask::taskMain, name, stackSize, this, uxTaskPriorityGet(nullptr), nullptr) != pdPASS) {
+        log_w("Failed to create task %s, running it now instead", name);
+        run(this);
+    }
+}
+
+BackgroundTask::~BackgroundTask()
+{
+    join();
+    vSemaphoreDelete(_done);
+}
+
+void BackgroundTask::join()
+{
+    // Give it back straight away so other tasks waiting on it also return
+    xSemaphoreTake(_done, portMAX_DELAY);
+    xSemaphoreGive(_done);
+}
+
+void BackgroundTask::run(void* arg)
+{
+    BackgroundTask *task = static_cast<BackgroundTask*>(arg);
+    const unsigned long start = micros();
+    task->_fn();
+    task->_micros = micros() - start;
+    xSemaphoreGive(task->_done);
+}
+
+void BackgroundTask::taskMain(void* arg)
+{
+    run(arg);
+    vTaskDelete(nullptr);
+}
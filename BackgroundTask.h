@@ -0,0 +1,38 @@
+#include <functional>
+#include "global.h"
+
+#ifndef PORTALCALENDAR_BACKGROUND_TASK_H
+#define PORTALCALENDAR_BACKGROUND_TASK_H
+
+/**
+ * Runs a function on its own FreeRTOS task, so network requests can wait on their responses at the same time.
+ * If the task can't be created, the function runs immediately on the calling task instead.
+ */
+class BackgroundTask
+{
+public:
+    BackgroundTask(const char* name, std::function<void(void)> fn, uint32_t stackSize = BACKGROUND_TASK_STACK_SIZE);
+    /**
+     * Waits for the function to finish
+     */
+    ~BackgroundTask();
+
+    /**
+     * Waits for the function to finish. Can be called from any number of tasks, and returns immediately once it has.
+     */
+    void join();
+
+    /**
+     * How long the function took to run. Only valid after join().
+     */
+    inline uint32_t getMicros() const { return _micros; }
+
+private:
+    static void run(void* arg);
+    static void taskMain(void* arg);
+    std::function<void(void)> _fn;
+    SemaphoreHandle_t _done;
+    uint32_t _micros = 0;
+};
+
+#endif // PORTALCALENDAR_BACKGROUND_TASK_H
@@ -1,9 +1,18 @@
+#ifndef NATIVE
 #include <mdns.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#endif
+#include <esp_rom_crc.h>
 #include "Configuration.h"
 #include "weather.h"
 #include "time_util.h"
 #include "Display.h"
+#include "profiler.h"
+#include "energy.h"
+#ifndef NATIVE
 #include "resources/www/index_html.h"
+#endif
 
 #define HTTP_OK 200
 #define HTTP_ACCEPTED 202
@@ -41,33 +50,173 @@
 #define KEY_SHOW_24_HOUR_TIME "show24Hr"
 #define KEY_MAX_RTC_CORRECTION_FACTOR "rtcCorrection"
 #define KEY_2_NTP_SYNCS_PER_DAY "twoNtpSyncs"
+#define KEY_SPI_CLOCK "spiClock"
+#define KEY_BATTERY_CAPACITY "batteryMah"
+
+/**
+ * Increase when ConfigSnapshot changes, so a snapshot left in RTC memory by older firmware isn't used
+ */
+#define CONFIG_SNAPSHOT_VERSION 1
+
+/**
+ * Every setting that's read on a normal wake, loaded from flash once and then kept in RTC memory so later wakes don't
+ * need to read flash at all. Settings that are only used to connect to the network, which can be much longer, are still
+ * read from flash when they're needed.
+ */
+struct ConfigSnapshot
+{
+    /**
+     * CRC32 of everything after this field
+     */
+    uint32_t crc;
+    uint32_t spiClock;
+    uint32_t batteryCapacity;
+    float weatherLocationLatitude;
+    float weatherLocationLongitude;
+    float maxRtcCorrectionFactor;
+    uint8_t version;
+    uint8_t weatherStartHour;
+    WeatherDisplayType weatherDisplayType;
+    WeatherUnits weatherUnits;
+    WeatherSecondaryInfo weatherSecondaryInfo;
+    bool configured;
+    bool showDay;
+    bool showMonth;
+    bool showYear;
+    bool weatherEnabled;
+    bool show24HourTime;
+    bool twoNtpSyncsPerDay;
+    char locale[6];
+    char hostname[64];
+};
+
+RTC_DATA_ATTR ConfigSnapshot configSnapshot;
+
+#ifndef NATIVE
+/**
+ * The access point and address from the last full Wi-Fi connection, so later wakes can reconnect without scanning
+ * for the network or waiting for DHCP
+ */
+struct WifiReconnectCache
+{
+    /**
+     * When the full connection was made, or 0 if there's nothing cached
+     */
+    time_t connectedAt;
+    /**
+     * Length of the DHCP lease the router gave the address, or 0 if it isn't known
+     */
+    uint32_t leaseSeconds;
+    char ssid[33];
+    uint8_t bssid[6];
+    int32_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns0;
+    uint32_t dns1;
+};
+
+RTC_DATA_ATTR WifiReconnectCache wifiReconnectCache;
+#endif // NATIVE
 
 ConfigurationClass Config;
 
+static uint32_t getSnapshotCrc(const ConfigSnapshot& snapshot)
+{
+    return esp_rom_crc32_le(
+        0,
+        reinterpret_cast<const uint8_t*>(&snapshot) + sizeof(snapshot.crc),
+        sizeof(ConfigSnapshot) - sizeof(snapshot.crc)
+    );
+}
+
 ConfigurationClass::~ConfigurationClass()
 {
     _prefs.end();
+#ifndef NATIVE
     if (_httpServer) {
         delete _httpServer;
     }
     if (_dnsServer) {
         delete _dnsServer;
     }
+#endif
 }
 
 void ConfigurationClass::begin()
 {
+    if (_begun) {
+        return;
+    }
     if (!_prefs.begin("portalcalendar")) {
         abort();
     }
     pinMode(PD_PIN, PD_PIN_STATE == HIGH ? INPUT_PULLDOWN : INPUT_PULLUP);
+    _begun = true;
+
+    if (configSnapshot.version == CONFIG_SNAPSHOT_VERSION && configSnapshot.crc == getSnapshotCrc(configSnapshot)) {
+        log_i("Using settings from RTC memory");
+    } else {
+        loadSnapshot();
+    }
 }
 
 void ConfigurationClass::reset()
 {
     _prefs.clear();
+    loadSnapshot();
+}
+
+void ConfigurationClass::reload()
+{
+    begin();
+    loadSnapshot();
+}
+
+void ConfigurationClass::loadSnapshot()
+{
+    log_i("Loading settings from flash");
+    memset(&configSnapshot, 0, sizeof(ConfigSnapshot));
+    configSnapshot.version = CONFIG_SNAPSHOT_VERSION;
+    configSnapshot.spiClock = _prefs.getUInt(KEY_SPI_CLOCK, DEFAULT_SPI_CLOCK_HZ);
+    configSnapshot.batteryCapacity = _prefs.getUInt(KEY_BATTERY_CAPACITY, DEFAULT_BATTERY_CAPACITY_MAH);
+    configSnapshot.weatherLocationLatitude = _prefs.getFloat(KEY_WEATHER_LOCATION_LATITUDE, 0);
+    configSnapshot.weatherLocationLongitude = _prefs.getFloat(KEY_WEATHER_LOCATION_LONGITUDE, 0);
+    configSnapshot.maxRtcCorrectionFactor = _prefs.getFloat(KEY_MAX_RTC_CORRECTION_FACTOR, DEFAULT_MAX_RTC_CORRECTION_FACTOR);
+    configSnapshot.weatherStartHour = _prefs.getUChar(KEY_WEATHER_START_HOUR, DEFAULT_WEATHER_START_HOUR);
+    configSnapshot.weatherDisplayType = prefs_getEnum(KEY_WEATHER_DISPLAY_TYPE, DEFAULT_WEATHER_DISPLAY_TYPE);
+    configSnapshot.weatherUnits = prefs_getEnum(KEY_WEATHER_UNITS, DEFAULT_WEATHER_UNITS);
+    configSnapshot.weatherSecondaryInfo = prefs_getEnum(KEY_WEATHER_SECONDARY_INFO, DEFAULT_WEATHER_SECONDARY_INFO);
+    configSnapshot.showDay = _prefs.getBool(KEY_SHOW_DAY, DEFAULT_SHOW_DAY);
+    configSnapshot.showMonth = _prefs.getBool(KEY_SHOW_MONTH, DEFAULT_SHOW_MONTH);
+    configSnapshot.showYear = _prefs.getBool(KEY_SHOW_YEAR, DEFAULT_SHOW_YEAR);
+    configSnapshot.weatherEnabled = _prefs.getBool(KEY_WEATHER_ENABLED, false);
+    configSnapshot.show24HourTime = _prefs.getBool(KEY_SHOW_24_HOUR_TIME, DEFAULT_USE_24H_TIME);
+    configSnapshot.twoNtpSyncsPerDay = _prefs.getBool(KEY_2_NTP_SYNCS_PER_DAY, DEFAULT_2_NTP_SYNCS_PER_DAY);
+    strncpy(configSnapshot.locale, _prefs.getString(KEY_LOCALE, DEFAULT_LOCALE).c_str(), sizeof(configSnapshot.locale) - 1);
+    strncpy(configSnapshot.hostname, _prefs.getString(KEY_HOSTNAME, DEFAULT_HOSTNAME).c_str(), sizeof(configSnapshot.hostname) - 1);
+    configSnapshot.configured = !(
+        getWifiSsid().isEmpty() ||
+        getTimezoneName().isEmpty() ||
+        getPrimaryNtpServer().isEmpty() ||
+        getPrimaryTimezonedServer().isEmpty() ||
+        (configSnapshot.weatherEnabled && (
+            getOwmApiKey().isEmpty() ||
+            configSnapshot.weatherLocationLatitude == 0.0 ||
+            configSnapshot.weatherLocationLongitude == 0.0
+        ))
+    );
+    configSnapshot.crc = getSnapshotCrc(configSnapshot);
 }
 
+const ConfigSnapshot& ConfigurationClass::snapshot()
+{
+    begin();
+    return configSnapshot;
+}
+
+#ifndef NATIVE
 void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSaved)
 {
     Display.fastClear(true);
@@ -188,6 +337,7 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
         }
 
         _prefs.putString(KEY_HOSTNAME, hostname);
+        loadSnapshot();
 
         request->send(HTTP_OK);
     });
@@ -238,6 +388,7 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
             if (status == WL_CONNECTED) {
                 _prefs.putString(KEY_WIFI_SSID, ssid);
                 _prefs.putString(KEY_WIFI_PASS, password);
+                loadSnapshot();
 
                 AsyncJsonResponse *response = new AsyncJsonResponse();
                 JsonObject root = response->getRoot();
@@ -268,6 +419,8 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
         
         _prefs.remove(KEY_WIFI_SSID);
         _prefs.remove(KEY_WIFI_PASS);
+        loadSnapshot();
+        wifiReconnectCache.connectedAt = 0;
         if (WiFi.isConnected()) {
             WiFi.disconnect(false, true);
         }
@@ -315,6 +468,8 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
         root[KEY_SHOW_24_HOUR_TIME] = getShow24HourTime();
         root[KEY_2_NTP_SYNCS_PER_DAY] = getTwoNtpSyncsPerDay();
         root[KEY_MAX_RTC_CORRECTION_FACTOR] = getMaxRtcCorrectionFactor();
+        root[KEY_SPI_CLOCK] = getSpiClock();
+        root[KEY_BATTERY_CAPACITY] = getBatteryCapacity();
 
         response->setLength();
         request->send(response);
@@ -353,6 +508,9 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
         prefs_putJsonBool(body, KEY_SHOW_24_HOUR_TIME);
         prefs_putJsonBool(body, KEY_2_NTP_SYNCS_PER_DAY);
         prefs_putJsonFloat(body, KEY_MAX_RTC_CORRECTION_FACTOR, 0, 1);
+        prefs_putJsonUInt(body, KEY_SPI_CLOCK, MIN_SPI_CLOCK_HZ, MAX_SPI_CLOCK_HZ);
+        prefs_putJsonUInt(body, KEY_BATTERY_CAPACITY, MIN_BATTERY_CAPACITY_MAH, MAX_BATTERY_CAPACITY_MAH);
+        loadSnapshot();
 
         onSettingsSaved();
         request->send(HTTP_OK);
@@ -463,6 +621,100 @@ void ConfigurationClass::runConfigServer(std::function<void(void)> onSettingsSav
         });
     });
 
+    on("/display/spi-probe", HTTP_POST, [&](AsyncWebServerRequest *request) {
+        log_i("POST /display/spi-probe");
+
+        deferRequest(request, [](AsyncWebServerRequestSharedPtr request) {
+            const uint32_t clock = request->hasParam("clock", true) ? request->getParam("clock", true)->value().toInt() : 0;
+            bool allowed = false;
+            for (uint32_t probeClock : SPI_PROBE_CLOCKS_HZ) {
+                allowed |= clock == probeClock;
+            }
+            if (!allowed) {
+                return request->send(HTTP_BAD_REQUEST);
+            }
+
+            const uint32_t uploadMicros = Display.showSpiProbeScreen(clock);
+
+            AsyncJsonResponse *response = new AsyncJsonResponse();
+            JsonObject root = response->getRoot();
+            root["clock"] = clock;
+            root["uploadMs"] = uploadMicros / 1000;
+            // Both planes are 1 bit per pixel
+            root["throughputKbps"] = uploadMicros
+                ? (uint64_t)DisplayGDEW075T7::NATIVE_WIDTH * DisplayGDEW075T7::NATIVE_HEIGHT * 2 * 1000 / uploadMicros
+                : 0;
+            response->setLength();
+            request->send(response);
+        });
+    });
+
+    on("/wake-profiles", HTTP_GET, [&](AsyncWebServerRequest *request) {
+        log_i("GET /wake-profiles");
+
+        AsyncJsonResponse *response = new AsyncJsonResponse(true);
+        JsonArray wakes = response->getRoot();
+        for (size_t i = 0; i < getWakeProfileCount(); ++i) {
+            const WakeProfile &profile = getWakeProfile(i);
+            JsonObject wake = wakes.add<JsonObject>();
+            wake["wakeTime"] = profile.wakeTime;
+            wake["wakeupCause"] = profile.wakeupCause;
+            wake["sleepSeconds"] = profile.sleepSeconds;
+            uint32_t totalMicros = 0;
+            JsonObject phases = wake["phaseMicros"].to<JsonObject>();
+            for (size_t phase = 0; phase < WAKE_PHASE_COUNT; ++phase) {
+                phases[WAKE_PHASE_NAMES[phase]] = profile.phaseMicros[phase];
+                totalMicros += profile.phaseMicros[phase];
+            }
+            wake["totalMicros"] = totalMicros;
+            JsonObject syncs = wake["syncMicros"].to<JsonObject>();
+            for (size_t sync = 0; sync < WAKE_SYNC_COUNT; ++sync) {
+                syncs[WAKE_SYNC_NAMES[sync]] = profile.syncMicros[sync];
+            }
+        }
+        response->setLength();
+        request->send(response);
+    });
+
+    on("/diagnostics", HTTP_GET, [&](AsyncWebServerRequest *request) {
+        log_i("GET /diagnostics");
+
+        const EnergyTotals &totals = getEnergyTotals();
+        const float remainingDays = getRemainingBatteryDays(time(nullptr));
+
+        AsyncJsonResponse *response = new AsyncJsonResponse();
+        JsonObject root = response->getRoot();
+        root["batteryCapacityMah"] = getBatteryCapacity();
+        root["usedMah"] = getUsedMah();
+        if (remainingDays >= 0) {
+            root["remainingDays"] = remainingDays;
+        } else {
+            root["remainingDays"] = nullptr;
+        }
+        root["since"] = totals.since;
+        root["wakes"] = totals.wakes;
+        root["sleepSeconds"] = totals.sleepSeconds;
+        root["sleepMah"] = totals.sleepMah;
+        root["sleepCurrentUa"] = DEEP_SLEEP_CURRENT_UA;
+        JsonObject phaseMah = root["phaseMah"].to<JsonObject>();
+        JsonObject phaseCurrentMa = root["phaseCurrentMa"].to<JsonObject>();
+        for (size_t phase = 0; phase < WAKE_PHASE_COUNT; ++phase) {
+            phaseMah[WAKE_PHASE_NAMES[phase]] = totals.phaseMah[phase];
+            phaseCurrentMa[WAKE_PHASE_NAMES[phase]] = getPhaseCurrentMa(static_cast<WakePhase>(phase));
+        }
+        response->setLength();
+        request->send(response);
+    });
+
+    on("/diagnostics/display", HTTP_POST, [&](AsyncWebServerRequest *request) {
+        log_i("POST /diagnostics/display");
+
+        deferRequest(request, [](AsyncWebServerRequestSharedPtr request) {
+            Display.showDiagnosticsScreen(time(nullptr));
+            request->send(HTTP_OK);
+        });
+    });
+
     on("/shutdown", HTTP_POST, [&](AsyncWebServerRequest *request) {
         log_i("POST /shutdown");
 
@@ -565,14 +817,103 @@ void ConfigurationClass::deferRequest(AsyncWebServerRequest *request, ArDeferred
     }
 }
 
+static bool canFastReconnect(const String& ssid)
+{
+    const time_t now = time(nullptr);
+    return wifiReconnectCache.connectedAt
+        && ssid.equals(wifiReconnectCache.ssid)
+        && now >= wifiReconnectCache.connectedAt
+        && now - wifiReconnectCache.connectedAt < WIFI_FAST_RECONNECT_MAX_AGE_HOURS * SECONDS_PER_HOUR;
+}
+
+/**
+ * Whether the cached address can be used again without asking DHCP. Fast reconnects don't renew the lease, so it's
+ * only reused until the point where the DHCP client would have renewed it, half way through the lease.
+ */
+static bool canReuseAddress()
+{
+    return time(nullptr) - wifiReconnectCache.connectedAt < static_cast<time_t>(wifiReconnectCache.leaseSeconds / 2);
+}
+
+/**
+ * Gets the length of the lease the DHCP client was given for the station interface, or 0 if it doesn't have one
+ */
+static uint32_t getDhcpLeaseSeconds()
+{
+    esp_netif_t *netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    struct netif *lwipNetif = netif ? static_cast<struct netif*>(esp_netif_get_netif_impl(netif)) : nullptr;
+    const struct dhcp *dhcp = lwipNetif ? netif_dhcp_data(lwipNetif) : nullptr;
+    return dhcp && dhcp->state == DHCP_STATE_BOUND ? dhcp->offered_t0_lease : 0;
+}
+
+static void saveWifiReconnectCache(const String& ssid)
+{
+    wifiReconnectCache.connectedAt = time(nullptr);
+    wifiReconnectCache.leaseSeconds = getDhcpLeaseSeconds();
+    strncpy(wifiReconnectCache.ssid, ssid.c_str(), sizeof(wifiReconnectCache.ssid) - 1);
+    memcpy(wifiReconnectCache.bssid, WiFi.BSSID(), sizeof(wifiReconnectCache.bssid));
+    wifiReconnectCache.channel = WiFi.channel();
+    wifiReconnectCache.ip = WiFi.localIP();
+    wifiReconnectCache.gateway = WiFi.gatewayIP();
+    wifiReconnectCache.subnet = WiFi.subnetMask();
+    wifiReconnectCache.dns0 = WiFi.dnsIP(0);
+    wifiReconnectCache.dns1 = WiFi.dnsIP(1);
+}
+
 wl_status_t ConfigurationClass::connectToWifi(String ssid, String password)
 {
     if (WiFi.isConnected() && ssid.equals(WiFi.SSID())) {
         return WL_CONNECTED;
     }
+    ProfilePhase phase(WakePhase::WIFI);
 
     wl_status_t status = WL_DISCONNECTED;
     unsigned int start = millis();
+
+    if (canFastReconnect(ssid)) {
+        // Once the lease is too old, still skip the scan but get an address from DHCP
+        const bool reuseAddress = canReuseAddress();
+        log_i(
+            "Reconnecting to Wi-Fi network '%s' on channel %d%s...",
+            ssid.c_str(),
+            wifiReconnectCache.channel,
+            reuseAddress ? "" : " using DHCP"
+        );
+        if (reuseAddress) {
+            WiFi.config(
+                IPAddress(wifiReconnectCache.ip),
+                IPAddress(wifiReconnectCache.gateway),
+                IPAddress(wifiReconnectCache.subnet),
+                IPAddress(wifiReconnectCache.dns0),
+                IPAddress(wifiReconnectCache.dns1)
+            );
+        }
+        WiFi.begin(
+            ssid.c_str(),
+            password.isEmpty() ? nullptr : password.c_str(),
+            wifiReconnectCache.channel,
+            wifiReconnectCache.bssid
+        );
+        // Kept short either way, since a full connection is made if this fails
+        status = static_cast<wl_status_t>(WiFi.waitForConnectResult(WIFI_FAST_RECONNECT_TIMEOUT_MS));
+        if (status == WL_CONNECTED) {
+            log_i("Reconnected to '%s' at %s after %ums", ssid.c_str(), WiFi.localIP().toString().c_str(), millis() - start);
+            if (!reuseAddress) {
+                // New lease, so the address can be reused from now on
+                saveWifiReconnectCache(ssid);
+            }
+            return status;
+        }
+        log_w("Fast reconnect failed with status %u, doing a full connection", status);
+        wifiReconnectCache.connectedAt = 0;
+        WiFi.disconnect();
+        if (reuseAddress) {
+            // Back to DHCP
+            WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);
+        }
+        start = millis();
+    }
+
     for (unsigned int attempts = 1, elapsed = 0;
         attempts <= 5 && elapsed < WIFI_CONNECTION_TIMEOUT_MS && status != WL_CONNECTED;
         ++attempts, elapsed = millis() - start
@@ -580,9 +921,14 @@ wl_status_t ConfigurationClass::connectToWifi(String ssid, String password)
         log_i("Connecting to Wi-Fi network '%s' attempt %u...", ssid.c_str(), attempts);
         WiFi.begin(ssid.c_str(), password.isEmpty() ? nullptr : password.c_str());
         status = static_cast<wl_status_t>(WiFi.waitForConnectResult(WIFI_CONNECTION_TIMEOUT_MS - elapsed));
+        if (status == WL_NO_SSID_AVAIL) {
+            // The scan didn't find the network, so retrying right away won't either
+            break;
+        }
     }
     if (status == WL_CONNECTED) {
         log_i("Connected to '%s' at %s after %ums", ssid.c_str(), WiFi.localIP().toString().c_str(), millis() - start);
+        saveWifiReconnectCache(ssid);
     } else {
         log_e("Failed to connect to '%s'", ssid.c_str());
     }
@@ -598,37 +944,41 @@ bool ConfigurationClass::connectToSavedWifi()
     log_i("No saved Wi-Fi network to connect to");
     return false;
 }
+#endif // NATIVE
 
 String ConfigurationClass::getWifiSsid() { return _prefs.getString(KEY_WIFI_SSID); }
 String ConfigurationClass::getWifiPass() { return _prefs.getString(KEY_WIFI_PASS); }
-String ConfigurationClass::getHostname() { return _prefs.getString(KEY_HOSTNAME, DEFAULT_HOSTNAME); }
-bool ConfigurationClass::getShowDay() { return _prefs.getBool(KEY_SHOW_DAY, DEFAULT_SHOW_DAY); }
-bool ConfigurationClass::getShowMonth() { return _prefs.getBool(KEY_SHOW_MONTH, DEFAULT_SHOW_MONTH); }
-bool ConfigurationClass::getShowYear() { return _prefs.getBool(KEY_SHOW_YEAR, DEFAULT_SHOW_YEAR); }
+String ConfigurationClass::getHostname() { return snapshot().hostname; }
+bool ConfigurationClass::getShowDay() { return snapshot().showDay; }
+bool ConfigurationClass::getShowMonth() { return snapshot().showMonth; }
+bool ConfigurationClass::getShowYear() { return snapshot().showYear; }
 String ConfigurationClass::getTimezoneName() { return _prefs.getString(KEY_TIMEZONE_NAME); }
-String ConfigurationClass::getLocale() { return _prefs.getString(KEY_LOCALE, DEFAULT_LOCALE); }
+String ConfigurationClass::getLocale() { return snapshot().locale; }
 String ConfigurationClass::getPrimaryNtpServer() { return _prefs.getString(KEY_PRIMARY_NTP_SERVER, DEFAULT_PRIMARY_NTP_SERVER); }
 String ConfigurationClass::getSecondaryNtpServer() { return _prefs.getString(KEY_SECONDARY_NTP_SERVER, DEFAULT_SECONDARY_NTP_SERVER); }
 String ConfigurationClass::getPrimaryTimezonedServer() { return _prefs.getString(KEY_PRIMARY_TIMEZONED_SERVER, DEFAULT_PRIMARY_TIMEZONED_SERVER); }
 String ConfigurationClass::getSecondaryTimezonedServer() { return _prefs.getString(KEY_SECONDARY_TIMEZONED_SERVER, DEFAULT_SECONDARY_TIMEZONED_SERVER); }
-bool ConfigurationClass::getWeatherEnabled() { return _prefs.getBool(KEY_WEATHER_ENABLED, false); }
+bool ConfigurationClass::getWeatherEnabled() { return snapshot().weatherEnabled; }
 String ConfigurationClass::getOwmApiKey() { return _prefs.getString(KEY_OWM_API_KEY); }
 String ConfigurationClass::getWeatherLocationName() { return _prefs.getString(KEY_WEATHER_LOCATION_NAME); }
-float ConfigurationClass::getWeatherLocationLatitude() { return _prefs.getFloat(KEY_WEATHER_LOCATION_LATITUDE, 0); }
-float ConfigurationClass::getWeatherLocationLongitude() { return _prefs.getFloat(KEY_WEATHER_LOCATION_LONGITUDE, 0); }
-WeatherDisplayType ConfigurationClass::getWeatherDisplayType() { return prefs_getEnum(KEY_WEATHER_DISPLAY_TYPE, DEFAULT_WEATHER_DISPLAY_TYPE); }
-WeatherUnits ConfigurationClass::getWeatherUnits() { return prefs_getEnum(KEY_WEATHER_UNITS, DEFAULT_WEATHER_UNITS); }
-WeatherSecondaryInfo ConfigurationClass::getWeatherSecondaryInfo() { return prefs_getEnum(KEY_WEATHER_SECONDARY_INFO, DEFAULT_WEATHER_SECONDARY_INFO); }
-uint8_t ConfigurationClass::getWeatherStartHour() { return _prefs.getUChar(KEY_WEATHER_START_HOUR, DEFAULT_WEATHER_START_HOUR); }
-bool ConfigurationClass::getShow24HourTime() { return _prefs.getBool(KEY_SHOW_24_HOUR_TIME, DEFAULT_USE_24H_TIME); }
-float ConfigurationClass::getMaxRtcCorrectionFactor() { return _prefs.getFloat(KEY_MAX_RTC_CORRECTION_FACTOR, DEFAULT_MAX_RTC_CORRECTION_FACTOR); }
-bool ConfigurationClass::getTwoNtpSyncsPerDay() { return _prefs.getFloat(KEY_2_NTP_SYNCS_PER_DAY, DEFAULT_2_NTP_SYNCS_PER_DAY); }
+float ConfigurationClass::getWeatherLocationLatitude() { return snapshot().weatherLocationLatitude; }
+float ConfigurationClass::getWeatherLocationLongitude() { return snapshot().weatherLocationLongitude; }
+WeatherDisplayType ConfigurationClass::getWeatherDisplayType() { return snapshot().weatherDisplayType; }
+WeatherUnits ConfigurationClass::getWeatherUnits() { return snapshot().weatherUnits; }
+WeatherSecondaryInfo ConfigurationClass::getWeatherSecondaryInfo() { return snapshot().weatherSecondaryInfo; }
+uint8_t ConfigurationClass::getWeatherStartHour() { return snapshot().weatherStartHour; }
+bool ConfigurationClass::getShow24HourTime() { return snapshot().show24HourTime; }
+float ConfigurationClass::getMaxRtcCorrectionFactor() { return snapshot().maxRtcCorrectionFactor; }
+bool ConfigurationClass::getTwoNtpSyncsPerDay() { return snapshot().twoNtpSyncsPerDay; }
+uint32_t ConfigurationClass::getSpiClock() { return snapshot().spiClock; }
+uint32_t ConfigurationClass::getBatteryCapacity() { return snapshot().batteryCapacity; }
 
 template <typename T>T ConfigurationClass::prefs_getEnum(const char* key, T defaultValue)
 {
     return static_cast<T>(_prefs.getUChar(key, static_cast<uint8_t>(defaultValue)));
 }
 
+#ifndef NATIVE
 void ConfigurationClass::prefs_putJsonFloat(const JsonObject& json, const char* key, float min, float max)
 {
     JsonVariant value = json[key];
@@ -659,6 +1009,21 @@ void ConfigurationClass::prefs_putJsonUChar(const JsonObject& json, const char*
     }
 }
 
+void ConfigurationClass::prefs_putJsonUInt(const JsonObject& json, const char* key, uint32_t min, uint32_t max)
+{
+    JsonVariant value = json[key];
+    if (value.is<uint32_t>()) {
+        uint32_t v = value.as<uint32_t>();
+        if (v >= min && v <= max) {
+            _prefs.putUInt(key, v);
+        } else {
+            log_w("Value %u is out of range (%u-%u) for %s", v, min, max, key);
+        }
+    } else if (!value.isNull()) {
+        log_w("Value for %s cannot be converted to uint", key);
+    }
+}
+
 void ConfigurationClass::prefs_putJsonString(const JsonObject& json, const char* key, unsigned int minLength, unsigned int maxLength)
 {
     JsonVariant value = json[key];
@@ -700,22 +1065,14 @@ template<typename T> void ConfigurationClass::prefs_putJsonEnum(const JsonObject
         log_w("Value for %s cannot be converted to uchar", key);
     }
 }
+#endif // NATIVE
 
 bool ConfigurationClass::isConfigured()
 {
-    return !(
-        getWifiSsid().isEmpty() ||
-        getTimezoneName().isEmpty() ||
-        getPrimaryNtpServer().isEmpty() ||
-        getPrimaryTimezonedServer().isEmpty() ||
-        (getWeatherEnabled() && (
-            getOwmApiKey().isEmpty() ||
-            getWeatherLocationLatitude() == 0.0 ||
-            getWeatherLocationLongitude() == 0.0
-        ))
-    );
+    return snapshot().configured;
 }
 
+#ifndef NATIVE
 bool ConfigurationClass::isApRequest(AsyncWebServerRequest *request)
 {
     // TODO is there a better way to determine this?
@@ -734,3 +1091,4 @@ AsyncCallbackJsonWebHandler& ConfigurationClass::on(const char* uri, WebRequestM
     _httpServer->addHandler(handler);
     return *handler;
 }
+#endif // NATIVE
@@ -1,21 +1,29 @@
+#ifndef NATIVE
 #include <ArduinoJson.h>
 #include <AsyncJson.h>
 #include <AsyncTCP.h>
 #include <DNSServer.h>
 #include <ESPAsyncWebServer.h>
-#include <Preferences.h>
 #include <WiFi.h>
+#endif
+#include <Preferences.h>
 #include "global.h"
 
 #ifndef PORTALCALENDAR_CONFIGURATION_H
 #define PORTALCALENDAR_CONFIGURATION_H
 
+struct ConfigSnapshot;
+
 class ConfigurationClass
 {
 public:
     ~ConfigurationClass();
     void begin();
     void reset();
+    /**
+     * Rereads every setting from flash. Only needed if the preferences were changed without going through this class.
+     */
+    void reload();
     void runConfigServer(std::function<void(void)> onSettingsSaved);
     bool isConfigured();
     bool connectToSavedWifi();
@@ -44,6 +52,8 @@ public:
     bool getShow24HourTime();
     float getMaxRtcCorrectionFactor();
     bool getTwoNtpSyncsPerDay();
+    uint32_t getSpiClock();
+    uint32_t getBatteryCapacity();
 
     inline bool isOnUsbPower()
     {
@@ -51,6 +61,14 @@ public:
     }
 
 private:
+    Preferences _prefs;
+    bool _begun = false;
+
+    template<typename T> T prefs_getEnum(const char* key, T defaultValue);
+    void loadSnapshot();
+    const ConfigSnapshot& snapshot();
+
+#ifndef NATIVE
     typedef std::shared_ptr<AsyncWebServerRequest> AsyncWebServerRequestSharedPtr;
     typedef std::function<void(AsyncWebServerRequestSharedPtr)> ArDeferredRequestHandlerFunction;
     typedef struct {
@@ -59,7 +77,6 @@ private:
     } DeferredRequest;
 
     QueueHandle_t _deferredRequestQueue;
-    Preferences _prefs;
     DNSServer *_dnsServer = nullptr;
     AsyncWebServer *_httpServer = nullptr;
 
@@ -67,15 +84,16 @@ private:
     bool isApRequest(AsyncWebServerRequest *request);
     wl_status_t connectToWifi(String ssid, String password);
 
-    template<typename T> T prefs_getEnum(const char* key, T defaultValue);
     void prefs_putJsonBool(const JsonObject& json, const char* key);
     void prefs_putJsonString(const JsonObject& json, const char* key, unsigned int minLength = 0, unsigned int maxLength = 1024);
     void prefs_putJsonFloat(const JsonObject& json, const char* key, float min, float max);
     void prefs_putJsonUChar(const JsonObject& json, const char* key, uint8_t min, uint8_t max);
+    void prefs_putJsonUInt(const JsonObject& json, const char* key, uint32_t min, uint32_t max);
     template<typename T> void prefs_putJsonEnum(const JsonObject& json, const char* key, std::initializer_list<T> values);
 
     AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
     AsyncCallbackJsonWebHandler& on(const char* uri, WebRequestMethodComposite method, ArJsonRequestHandlerFunction onRequest);
+#endif // NATIVE
 };
 
 extern ConfigurationClass Config;
@@ -1,8 +1,11 @@
+#include <esp_rom_crc.h>
 #include "Display.h"
 #include "global.h"
 #include "Configuration.h"
 #include "time_util.h"
 #include "qrcodegen.h"
+#include "profiler.h"
+#include "energy.h"
 
 #include "resources/font/medium.h"
 #include "resources/font/small.h"
@@ -247,6 +250,25 @@ static_assert(
 
 DisplayClass Display;
 
+#define TILE_COUNT FrameBuffer::getTileCount(DisplayGDEW075T7::NATIVE_WIDTH, DisplayGDEW075T7::NATIVE_HEIGHT)
+
+// refresh() hashes every tile that hasn't been drawn on as the same blank tile, so they all need to be the same size
+static_assert(
+    DisplayGDEW075T7::NATIVE_WIDTH % FrameBuffer::TILE_WIDTH == 0 && DisplayGDEW075T7::NATIVE_HEIGHT % FrameBuffer::TILE_HEIGHT == 0,
+    "The display must be an exact number of tiles"
+);
+
+/**
+ * CRC of each frame buffer tile as it is currently shown on the display, so that the next refresh can
+ * tell which parts of the screen actually changed.
+ */
+RTC_DATA_ATTR uint32_t displayedTileCrcs[TILE_COUNT];
+RTC_DATA_ATTR bool displayedTileCrcsValid = false;
+/**
+ * Partial refreshes done since the last full refresh
+ */
+RTC_DATA_ATTR uint8_t partialRefreshCount = 0;
+
 DisplayClass::~DisplayClass()
 {
     cleanup();
@@ -255,7 +277,7 @@ DisplayClass::~DisplayClass()
 void DisplayClass::initDisplay()
 {
     if (!_display) {
-        _display = new DisplayGDEW075T7(SPI_BUS, CLK_PIN, DIN_PIN, CS_PIN, RESET_PIN, DC_PIN, BUSY_PIN, PWR_PIN);
+        _display = new DisplayGDEW075T7(SPI_BUS, CLK_PIN, DIN_PIN, CS_PIN, RESET_PIN, DC_PIN, BUSY_PIN, PWR_PIN, Config.getSpiClock());
     }
 }
 
@@ -270,6 +292,64 @@ void DisplayClass::initFrameBuffer()
     }
 }
 
+/**
+ * Refreshes only the part of the display that changed since the last refresh, based on the tile CRCs.
+ * Nothing is refreshed if the frame is the same, and a full refresh is done if most of the screen changed.
+ */
+void DisplayClass::refresh()
+{
+    uint32_t tileCrcs[TILE_COUNT];
+    uint32_t x, y, width, height;
+    // Bounding box of the changed tiles in native coordinates
+    uint32_t left = DisplayGDEW075T7::NATIVE_WIDTH, top = DisplayGDEW075T7::NATIVE_HEIGHT, right = 0, bottom = 0;
+    // Tiles that haven't been drawn on are all the clear color, so they only need to be hashed once
+    bool blankCrcValid = false;
+    uint32_t blankCrc = 0;
+
+    for (size_t tile = 0; tile < TILE_COUNT; ++tile) {
+        if (_frameBuffer->isTileDirty(tile) || !blankCrcValid) {
+            _frameBuffer->getTileRect(tile, &x, &y, &width, &height);
+            uint32_t crc = 0;
+            for (uint32_t row = y; row < y + height; ++row) {
+                crc = esp_rom_crc32_le(crc, &_frameBuffer->data[(row * DisplayGDEW075T7::NATIVE_WIDTH + x) / 4], width / 4);
+            }
+            tileCrcs[tile] = crc;
+            if (!_frameBuffer->isTileDirty(tile)) {
+                blankCrc = crc;
+                blankCrcValid = true;
+            }
+        } else {
+            tileCrcs[tile] = blankCrc;
+        }
+
+        if (!displayedTileCrcsValid || tileCrcs[tile] != displayedTileCrcs[tile]) {
+            _frameBuffer->getTileRect(tile, &x, &y, &width, &height);
+            left = min(left, x);
+            top = min(top, y);
+            right = max(right, x + width);
+            bottom = max(bottom, y + height);
+        }
+    }
+
+    if (right == 0) {
+        log_i("Frame is unchanged, skipping refresh");
+    } else if (
+        !displayedTileCrcsValid
+        || partialRefreshCount >= MAX_PARTIAL_REFRESHES
+        || (right - left) * (bottom - top) * 2 > DisplayGDEW075T7::NATIVE_WIDTH * DisplayGDEW075T7::NATIVE_HEIGHT
+    ) {
+        _display->refresh(_frameBuffer);
+        partialRefreshCount = 0;
+    } else {
+        log_i("Refreshing changed area %ux%u at %u,%u", right - left, bottom - top, left, top);
+        _display->refresh(_frameBuffer, left, top, right - left, bottom - top);
+        ++partialRefreshCount;
+    }
+
+    memcpy(displayedTileCrcs, tileCrcs, sizeof(displayedTileCrcs));
+    displayedTileCrcsValid = true;
+}
+
 void DisplayClass::cleanup()
 {
     if (_display) {
@@ -284,6 +364,7 @@ void DisplayClass::cleanup()
 
 void DisplayClass::update(const tm *now, const Locale& locale, bool showWeather)
 {
+    ProfilePhase phase(WakePhase::RENDER);
     initDisplay();
     initFrameBuffer();
 
@@ -349,7 +430,7 @@ void DisplayClass::update(const tm *now, const Locale& locale, bool showWeather)
         }
     }
 
-    _display->refresh(_frameBuffer);
+    refresh();
     cleanup();
 }
 
@@ -383,10 +464,11 @@ const Image* DisplayClass::getWeatherConditionIcon(WeatherCondition condition, b
 void DisplayClass::drawWeatherInfoText(const char* text, const Image* symbol, int32_t x, int32_t y)
 {
     if (symbol) {
-        uint32_t textWidth = _frameBuffer->measureText(text, FONT_SMALL);
+        const GlyphRun run = GlyphRun(text, FONT_SMALL);
+        uint32_t textWidth = _frameBuffer->measureText(run);
         // The extra /2 gives less weight to the symbol so the text appears more centered
         x -= (textWidth + symbol->width / 2) / 2;
-        _frameBuffer->drawText(text, FONT_SMALL, x, y);
+        _frameBuffer->drawText(run, x, y);
         _frameBuffer->drawImage(*symbol, x + textWidth, y);
     } else {
         _frameBuffer->drawText(text, FONT_SMALL, x, y, FrameBuffer::TOP_CENTER);
@@ -545,6 +627,7 @@ void DisplayClass::drawApertureLogo()
 
 void DisplayClass::error(String message, bool willRetry)
 {
+    ProfilePhase phase(WakePhase::RENDER);
     initDisplay();
     initFrameBuffer();
 
@@ -570,11 +653,12 @@ void DisplayClass::error(String message, bool willRetry)
         );
     }
 
-    _display->refresh(_frameBuffer);
+    refresh();
 }
 
 void DisplayClass::showWelcomeScreen()
 {
+    ProfilePhase phase(WakePhase::RENDER);
     initDisplay();
     initFrameBuffer();
 
@@ -591,7 +675,7 @@ void DisplayClass::showWelcomeScreen()
         360
     );
 
-    _display->refresh(_frameBuffer);
+    refresh();
 }
 
 void DisplayClass::fastClear(bool black)
@@ -599,10 +683,104 @@ void DisplayClass::fastClear(bool black)
     initDisplay();
 
     _display->fastClear(black);
+    displayedTileCrcsValid = false;
+
+    cleanup();
+}
+
+/**
+ * Uploads a test pattern at the given SPI clock and returns how long the upload took in microseconds.
+ * The grey bands and the text only come out clean if every byte arrived intact.
+ */
+uint32_t DisplayClass::showSpiProbeScreen(uint32_t spiClock)
+{
+    initDisplay();
+    initFrameBuffer();
 
+    _display->setSpiClock(spiClock);
+    _frameBuffer->test();
+
+    char buffer[24];
+    sprintf(buffer, "SPI %u.%02u MHz", spiClock / 1000000, spiClock / 10000 % 100);
+    _frameBuffer->fillRect(H_CENTER, _frameBuffer->getHeight() / 2, 300, 60, FrameBuffer::WHITE, FrameBuffer::CENTER);
+    _frameBuffer->drawText(buffer, FONT_MEDIUM, H_CENTER, _frameBuffer->getHeight() / 2, FrameBuffer::CENTER);
+
+    // Always upload the whole frame, since that's what is being measured
+    _display->refresh(_frameBuffer);
+    displayedTileCrcsValid = false;
+    const uint32_t uploadMicros = _display->getLastUploadMicros();
+    cleanup();
+    return uploadMicros;
+}
+
+void DisplayClass::showDiagnosticsScreen(time_t now)
+{
+    const int32_t ROW_HEIGHT = FONT_SMALL.ascent + FONT_SMALL.descent + 4;
+    const EnergyTotals &totals = getEnergyTotals();
+    const double usedMah = getUsedMah();
+    const float remainingDays = getRemainingBatteryDays(now);
+    char buffer[32];
+
+    ProfilePhase phase(WakePhase::RENDER);
+    initDisplay();
+    initFrameBuffer();
+
+    _frameBuffer->drawText("DIAGNOSTICS", FONT_MEDIUM, LEFT, 14);
+    _frameBuffer->drawHLine(LEFT, 50, WIDTH, 2, FrameBuffer::BLACK, FrameBuffer::TOP_LEFT);
+
+    int32_t y = 66;
+    sprintf(buffer, "%.1f / %u mAh", usedMah, Config.getBatteryCapacity());
+    drawDiagnosticsRow("Battery used", buffer, y);
+    y += ROW_HEIGHT;
+    if (remainingDays >= 0) {
+        sprintf(buffer, "%.0f days", remainingDays);
+        drawDiagnosticsRow("Battery left", buffer, y);
+    } else {
+        drawDiagnosticsRow("Battery left", "Not enough data", y);
+    }
+    y += ROW_HEIGHT;
+    if (totals.since) {
+        tm since;
+        localtime_r(&totals.since, &since);
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d", &since);
+        drawDiagnosticsRow("Counting since", buffer, y);
+    } else {
+        drawDiagnosticsRow("Counting since", "-", y);
+    }
+    y += ROW_HEIGHT;
+    sprintf(buffer, "%u", totals.wakes);
+    drawDiagnosticsRow("Wakes", buffer, y);
+    y += ROW_HEIGHT;
+    if (totals.since && now > totals.since) {
+        sprintf(buffer, "%.2f mAh", usedMah * SECONDS_PER_DAY / (now - totals.since));
+        drawDiagnosticsRow("Average per day", buffer, y);
+    } else {
+        drawDiagnosticsRow("Average per day", "-", y);
+    }
+    y += ROW_HEIGHT;
+
+    _frameBuffer->drawHLine(LEFT, y + 8, WIDTH, 2, FrameBuffer::BLACK, FrameBuffer::TOP_LEFT);
+    y += 24;
+    for (size_t i = 0; i < WAKE_PHASE_COUNT; ++i) {
+        sprintf(buffer, "%.2f mAh", totals.phaseMah[i]);
+        drawDiagnosticsRow(WAKE_PHASE_NAMES[i], buffer, y);
+        y += ROW_HEIGHT;
+    }
+    sprintf(buffer, "%.2f mAh", totals.sleepMah);
+    drawDiagnosticsRow("deepSleep", buffer, y);
+
+    drawApertureLogo();
+
+    refresh();
     cleanup();
 }
 
+void DisplayClass::drawDiagnosticsRow(const char* label, const char* value, int32_t y)
+{
+    _frameBuffer->drawText(label, FONT_SMALL, LEFT, y);
+    _frameBuffer->drawText(value, FONT_SMALL, RIGHT, y, FrameBuffer::TOP_RIGHT);
+}
+
 void DisplayClass::showConfigServerScreen(String ssid, String password, String hostname, String connectedWifiName)
 {
     const int32_t QR_SCALE = 6;
@@ -712,7 +890,7 @@ void DisplayClass::showConfigServerScreen(String ssid, String password, String h
         360
     );
 
-    _display->refresh(_frameBuffer);
+    refresh();
     cleanup();
 }
 
@@ -732,7 +910,7 @@ void DisplayClass::showDevWebserverScreen(String ssid, IPAddress localIp)
         _frameBuffer->getWidth(),
         FrameBuffer::TOP_CENTER
     );
-    _display->refresh(_frameBuffer);
+    refresh();
     cleanup();
 }
 
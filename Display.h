@@ -17,6 +17,8 @@ public:
     void showWelcomeScreen();
     void showConfigServerScreen(String ssid, String password, String hostname, String connectedWifiName);
     void fastClear(bool black = false);
+    uint32_t showSpiProbeScreen(uint32_t spiClock);
+    void showDiagnosticsScreen(time_t now);
     #ifdef DEV_WEBSERVER
     void showDevWebserverScreen(String ssid, IPAddress localIp);
     #endif
@@ -27,6 +29,7 @@ public:
 private:
     void initDisplay();
     void initFrameBuffer();
+    void refresh();
     void cleanup();
     const Image* getWeatherConditionIcon(WeatherCondition condition, bool day);
     void drawWeatherInfoText(const char* text, const Image* symbol, int32_t x, int32_t y);
@@ -36,6 +39,7 @@ private:
     void drawStandardSeparators();
     void drawChamberNumber(int number, int total);
     void drawApertureLogo();
+    void drawDiagnosticsRow(const char* label, const char* value, int32_t y);
     DisplayGDEW075T7 *_display = nullptr;
     FrameBuffer *_frameBuffer = nullptr;
 };
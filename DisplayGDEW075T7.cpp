@@ -7,8 +7,12 @@
  * https://www.smart-prototyping.com/image/data/9_Modules/EinkDisplay/GDEW0154T8/IL0373.pdf
  */
 
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
 #include "DisplayGDEW075T7.h"
 #include "config.h"
+#include "profiler.h"
 
 // Display commands
 const uint8_t CMD_PSR           = 0x00;
@@ -36,6 +40,9 @@ const uint8_t CMD_TRES          = 0x61;
 const uint8_t CMD_GSST          = 0x65;
 const uint8_t CMD_FLG           = 0x71;
 const uint8_t CMD_VDCS          = 0x82;
+const uint8_t CMD_PTL           = 0x90;
+const uint8_t CMD_PTIN          = 0x91;
+const uint8_t CMD_PTOUT         = 0x92;
 
 // Supported LUT voltage levels
 #define LEVEL_GND           0b00
@@ -218,24 +225,81 @@ const uint8_t LUT_BLACK_FAST_CLEAR[] = {
 };
 
 /**
- * These aren't waveform LUTs, they map 2-bit color values to the old (DTM1) and new (DTM2)
- * data values sent to the display.
+ * LUTs for partial refreshes of black and white content.
+ *
+ * These don't depend on what was previously on the screen (which is lost when the ESP32 deep sleeps), so every pixel
+ * in the window is briefly driven to the opposite color and then to its target. The timings are the ones GxEPD2 uses
+ * for fast partial updates on this display, and the whole waveform is a fraction of the length of the greyscale one.
+ *
+ * https://github.com/ZinggJM/GxEPD2/blob/master/src/epd/GxEPD2_750_T7.cpp
  */
 
-const uint8_t LUT_DTM1[] = {
-    /* WHITE */ 0,
-    /* LGREY */ 0,
-    /* DGREY */ 1,
-    /* BLACK */ 1,
+#define T_FAST_DRIVE 30
+#define T_FAST_REST 5
+
+const uint8_t LUT_VCOM_FAST[] = {
+    LUT_ROW(LEVEL_VCOM_VCMDC, T_FAST_DRIVE, LEVEL_VCOM_VCMDC, T_FAST_REST, LEVEL_VCOM_VCMDC, T_FAST_DRIVE, LEVEL_VCOM_VCMDC, T_FAST_REST, 1),
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+};
+
+const uint8_t LUT_WHITE_FAST[] = {
+    LUT_ROW(LEVEL_VDH, T_FAST_DRIVE, LEVEL_GND, T_FAST_REST, LEVEL_VDL, T_FAST_DRIVE, LEVEL_GND, T_FAST_REST, 1),
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+};
+
+const uint8_t LUT_BLACK_FAST[] = {
+    LUT_ROW(LEVEL_VDL, T_FAST_DRIVE, LEVEL_GND, T_FAST_REST, LEVEL_VDH, T_FAST_DRIVE, LEVEL_GND, T_FAST_REST, 1),
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
+    LUT_ROW_NOOP,
 };
 
-const uint8_t LUT_DTM2[] = {
-    /* WHITE */ 0,
-    /* LGREY */ 1,
-    /* DGREY */ 0,
-    /* BLACK */ 1,
+/**
+ * This isn't a waveform LUT, it maps 4 pixels of the 2-bit frame buffer to the old (DTM1) and new (DTM2)
+ * data bits sent to the display, so each plane can be packed with one lookup per frame buffer byte.
+ *
+ * The high nibble is the DTM1 bits and the low nibble is the DTM2 bits, with the first pixel in the most significant bit.
+ * Per pixel, WHITE is 0/0, LGREY is 0/1, DGREY is 1/0 and BLACK is 1/1.
+ */
+
+const uint8_t LUT_DTM[256] = {
+    0x00, 0x01, 0x10, 0x11, 0x02, 0x03, 0x12, 0x13, 0x20, 0x21, 0x30, 0x31, 0x22, 0x23, 0x32, 0x33,
+    0x04, 0x05, 0x14, 0x15, 0x06, 0x07, 0x16, 0x17, 0x24, 0x25, 0x34, 0x35, 0x26, 0x27, 0x36, 0x37,
+    0x40, 0x41, 0x50, 0x51, 0x42, 0x43, 0x52, 0x53, 0x60, 0x61, 0x70, 0x71, 0x62, 0x63, 0x72, 0x73,
+    0x44, 0x45, 0x54, 0x55, 0x46, 0x47, 0x56, 0x57, 0x64, 0x65, 0x74, 0x75, 0x66, 0x67, 0x76, 0x77,
+    0x08, 0x09, 0x18, 0x19, 0x0A, 0x0B, 0x1A, 0x1B, 0x28, 0x29, 0x38, 0x39, 0x2A, 0x2B, 0x3A, 0x3B,
+    0x0C, 0x0D, 0x1C, 0x1D, 0x0E, 0x0F, 0x1E, 0x1F, 0x2C, 0x2D, 0x3C, 0x3D, 0x2E, 0x2F, 0x3E, 0x3F,
+    0x48, 0x49, 0x58, 0x59, 0x4A, 0x4B, 0x5A, 0x5B, 0x68, 0x69, 0x78, 0x79, 0x6A, 0x6B, 0x7A, 0x7B,
+    0x4C, 0x4D, 0x5C, 0x5D, 0x4E, 0x4F, 0x5E, 0x5F, 0x6C, 0x6D, 0x7C, 0x7D, 0x6E, 0x6F, 0x7E, 0x7F,
+    0x80, 0x81, 0x90, 0x91, 0x82, 0x83, 0x92, 0x93, 0xA0, 0xA1, 0xB0, 0xB1, 0xA2, 0xA3, 0xB2, 0xB3,
+    0x84, 0x85, 0x94, 0x95, 0x86, 0x87, 0x96, 0x97, 0xA4, 0xA5, 0xB4, 0xB5, 0xA6, 0xA7, 0xB6, 0xB7,
+    0xC0, 0xC1, 0xD0, 0xD1, 0xC2, 0xC3, 0xD2, 0xD3, 0xE0, 0xE1, 0xF0, 0xF1, 0xE2, 0xE3, 0xF2, 0xF3,
+    0xC4, 0xC5, 0xD4, 0xD5, 0xC6, 0xC7, 0xD6, 0xD7, 0xE4, 0xE5, 0xF4, 0xF5, 0xE6, 0xE7, 0xF6, 0xF7,
+    0x88, 0x89, 0x98, 0x99, 0x8A, 0x8B, 0x9A, 0x9B, 0xA8, 0xA9, 0xB8, 0xB9, 0xAA, 0xAB, 0xBA, 0xBB,
+    0x8C, 0x8D, 0x9C, 0x9D, 0x8E, 0x8F, 0x9E, 0x9F, 0xAC, 0xAD, 0xBC, 0xBD, 0xAE, 0xAF, 0xBE, 0xBF,
+    0xC8, 0xC9, 0xD8, 0xD9, 0xCA, 0xCB, 0xDA, 0xDB, 0xE8, 0xE9, 0xF8, 0xF9, 0xEA, 0xEB, 0xFA, 0xFB,
+    0xCC, 0xCD, 0xDC, 0xDD, 0xCE, 0xCF, 0xDE, 0xDF, 0xEC, 0xED, 0xFC, 0xFD, 0xEE, 0xEF, 0xFE, 0xFF,
 };
 
+/**
+ * Number of bytes packed before each SPI write. This keeps the stack usage small while still
+ * sending large enough blocks to keep the SPI peripheral busy.
+ */
+#define SPI_CHUNK_SIZE 256
+
 #define BUSY_TIMEOUT 5000
 
 DisplayGDEW075T7::~DisplayGDEW075T7() {
@@ -254,13 +318,15 @@ DisplayGDEW075T7::DisplayGDEW075T7(
     uint8_t reset_pin,
     uint8_t dc_pin,
     uint8_t busy_pin,
-    uint8_t pwr_pin
+    uint8_t pwr_pin,
+    uint32_t spi_clock
 ) {
     _resetPin = reset_pin;
     _dcPin = dc_pin;
     _csPin = cs_pin;
     _busyPin = busy_pin;
     _pwrPin = pwr_pin;
+    _spiClock = spi_clock;
 
     pinMode(_csPin, OUTPUT);
     pinMode(_resetPin, OUTPUT);
@@ -271,10 +337,19 @@ DisplayGDEW075T7::DisplayGDEW075T7(
     #ifndef HEADLESS
     _spi = new SPIClass(spi_bus);
     _spi->begin(sck_pin, -1, copi_pin, cs_pin);
-    _spi->beginTransaction(SPISettings(7000000, MSBFIRST, SPI_MODE0));
+    _spi->beginTransaction(SPISettings(_spiClock, MSBFIRST, SPI_MODE0));
     #endif
 };
 
+void DisplayGDEW075T7::setSpiClock(uint32_t clock)
+{
+    _spiClock = clock;
+    #ifndef HEADLESS
+    _spi->endTransaction();
+    _spi->beginTransaction(SPISettings(_spiClock, MSBFIRST, SPI_MODE0));
+    #endif
+}
+
 void DisplayGDEW075T7::wakeup()
 {
     digitalWrite(_pwrPin, HIGH);
@@ -355,78 +430,212 @@ void DisplayGDEW075T7::sendData(uint8_t data)
     #endif
 }
 
-void DisplayGDEW075T7::waitUntilIdle()
+void DisplayGDEW075T7::sendData(const uint8_t *data, size_t length)
 {
     #ifndef HEADLESS
-    unsigned long start = millis();
-    do {
-        delay(5);
-    } while (digitalRead(_busyPin) == LOW && millis() - start < BUSY_TIMEOUT);
+    _spi->writeBytes(data, length);
     #endif
+}
+
+/**
+ * Sends one data plane of a window of the frame buffer. x and width must be multiples of 8.
+ * Returns true if the window has any grey pixels, which is when the DTM1 and DTM2 bits of a pixel differ.
+ */
+bool DisplayGDEW075T7::sendPlane(uint8_t command, const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    // DTM1 takes the high nibbles of LUT_DTM and DTM2 the low nibbles
+    const uint8_t shift = command == CMD_DTM1 ? 0 : 4;
+    const uint8_t *data = frameBuffer->data;
+    uint8_t chunk[SPI_CHUNK_SIZE];
+    size_t n = 0;
+    uint8_t greys = 0;
+
+    sendCommand(command);
+    for (const uint32_t yEnd = y + height; y < yEnd; ++y) {
+        const uint8_t *src = &data[(NATIVE_WIDTH * y + x) / 4];
+        const uint8_t *rowEnd = src + width / 4;
+        // Each output byte holds 8px, which is 2 bytes of the frame buffer
+        for (; src < rowEnd; src += 2) {
+            const uint8_t first = LUT_DTM[src[0]];
+            const uint8_t second = LUT_DTM[src[1]];
+            greys |= (first ^ (first >> 4)) | (second ^ (second >> 4));
+            chunk[n++] = (((first << shift) & 0xF0) | (((second << shift) & 0xF0) >> 4));
+            if (n == SPI_CHUNK_SIZE) {
+                sendData(chunk, n);
+                n = 0;
+            }
+        }
+    }
+    if (n) {
+        sendData(chunk, n);
+    }
+    return greys & 0x0F;
+}
+
+bool DisplayGDEW075T7::upload(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    ProfilePhase phase(WakePhase::SPI_UPLOAD);
+    const unsigned long uploadStart = micros();
+    const bool hasGreys = sendPlane(CMD_DTM1, frameBuffer, x, y, width, height);
+    sendPlane(CMD_DTM2, frameBuffer, x, y, width, height);
+    _lastUploadMicros = micros() - uploadStart;
+    log_i("Uploaded %ux%u window in %ums at %uHz", width, height, _lastUploadMicros / 1000, _spiClock);
+    return hasGreys;
+}
+
+static void IRAM_ATTR onBusyIdle(void *task)
+{
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(static_cast<TaskHandle_t>(task), &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * Waits for BUSY to go high without polling. Refreshes keep the controller busy for several seconds, so if the radio
+ * is off the CPU is put into light sleep with a GPIO wakeup on BUSY. Light sleep would drop a Wi-Fi connection
+ * (such as the config server AP), so in that case the task blocks on a notification from a BUSY interrupt instead.
+ */
+void DisplayGDEW075T7::waitUntilIdle()
+{
+    #ifndef HEADLESS
+    const unsigned long start = millis();
+    // Give the controller a moment to pull BUSY low after the last command
+    delay(5);
+    if (digitalRead(_busyPin) == HIGH) {
+        return;
+    }
+
+    const gpio_num_t busyPin = static_cast<gpio_num_t>(_busyPin);
+    const unsigned long timeout = BUSY_TIMEOUT - (millis() - start);
+    if (WiFi.getMode() == WIFI_MODE_NULL) {
+        gpio_wakeup_enable(busyPin, GPIO_INTR_HIGH_LEVEL);
+        esp_sleep_enable_gpio_wakeup();
+        esp_sleep_enable_timer_wakeup(timeout * 1000);
+        esp_light_sleep_start();
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+        esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+        gpio_wakeup_disable(busyPin);
+    } else {
+        // Clear any stale notification before arming the interrupt
+        ulTaskNotifyTake(pdTRUE, 0);
+        attachInterruptArg(_busyPin, onBusyIdle, xTaskGetCurrentTaskHandle(), RISING);
+        // BUSY may have gone high before the interrupt was attached
+        if (digitalRead(_busyPin) == LOW) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout));
+        }
+        detachInterrupt(_busyPin);
+    }
+
+    if (digitalRead(_busyPin) == LOW) {
+        log_e("Display still busy after %ums", BUSY_TIMEOUT);
+    } else {
+        log_i("Display was busy for %ums", millis() - start);
+    }
+    #else
     delay(20);
+    #endif
 }
 
 void DisplayGDEW075T7::setLut(uint8_t cmd, const uint8_t* lut)
 {
     sendCommand(cmd);
-    for (size_t i = 0; i < 42; ++i) {
-        sendData(lut[i]);
-    }
+    sendData(lut, 42);
+}
+
+/**
+ * Sets the waveforms for each of the 4 frame buffer colors. The border uses the white waveform.
+ */
+void DisplayGDEW075T7::setLuts(const uint8_t* vcom, const uint8_t* white, const uint8_t* lgrey, const uint8_t* dgrey, const uint8_t* black)
+{
+    setLut(CMD_SET_LUTVCOM, vcom);
+    setLut(CMD_SET_LUTWW, white);
+    setLut(CMD_SET_LUTBW, dgrey);
+    setLut(CMD_SET_LUTWB, lgrey);
+    setLut(CMD_SET_LUTBB, black);
+    setLut(CMD_SET_LUTBD, white);
 }
 
 void DisplayGDEW075T7::refresh(const FrameBuffer *frameBuffer)
 {
+    ProfilePhase phase(WakePhase::PANEL_REFRESH);
     wakeup();
 
-    setLut(CMD_SET_LUTVCOM, LUT_VCOM_2BIT);
-    setLut(CMD_SET_LUTWW, LUT_WHITE_2BIT);
-    setLut(CMD_SET_LUTBW, LUT_DGREY_2BIT);
-    setLut(CMD_SET_LUTWB, LUT_LGREY_2BIT);
-    setLut(CMD_SET_LUTBB, LUT_BLACK_2BIT);
-    setLut(CMD_SET_LUTBD, LUT_WHITE_2BIT);
-
-    size_t i;
-    uint8_t j;
-    uint16_t chunk; // Holds 8px of frame_buffer
-    uint8_t output;   // Holds 8px of display output
-    size_t len = frameBuffer->getLength();
-    const uint8_t *data = frameBuffer->data;
+    setLuts(LUT_VCOM_2BIT, LUT_WHITE_2BIT, LUT_LGREY_2BIT, LUT_DGREY_2BIT, LUT_BLACK_2BIT);
+    upload(frameBuffer, 0, 0, NATIVE_WIDTH, NATIVE_HEIGHT);
 
-    sendCommand(CMD_DTM1);
-    for (i = 0; i < len; i += 2) {
-        output = 0;
-        chunk = (data[i] << 8) | data[i + 1];
-        for (j = 0; j < 8; ++j) {
-            output |= LUT_DTM1[(chunk >> (j * 2)) & 0b11] << j;
-        }
-        sendData(output);
+    sendCommand(CMD_REFRESH);
+    delay(100);
+    waitUntilIdle();
+    sleep();
+}
+
+/**
+ * Refreshes only a window of the display, given in native coordinates. The rest of the screen is left as it is.
+ *
+ * The window is widened to a multiple of 8 pixels horizontally, since that's the granularity of the controller.
+ * If everything in the window is black or white, the fast 1-bit waveform is used, otherwise the window is refreshed
+ * with the same greyscale waveform as a full refresh.
+ */
+void DisplayGDEW075T7::refresh(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    width += x % 8;
+    x -= x % 8;
+    width = (width + 7) & ~7u;
+    if (x >= NATIVE_WIDTH || y >= NATIVE_HEIGHT) {
+        return;
     }
-    sendCommand(CMD_DTM2);
-    for (i = 0; i < len; i += 2) {
-        output = 0;
-        chunk = (data[i] << 8) | data[i + 1];
-        for (j = 0; j < 8; ++j) {
-            output |= LUT_DTM2[(chunk >> (j * 2)) & 0b11] << j;
-        }
-        sendData(output);
+    if (x + width > NATIVE_WIDTH) {
+        width = NATIVE_WIDTH - x;
+    }
+    if (y + height > NATIVE_HEIGHT) {
+        height = NATIVE_HEIGHT - y;
+    }
+    if (!width || !height) {
+        return;
+    }
+
+    ProfilePhase phase(WakePhase::PANEL_REFRESH);
+    wakeup();
+
+    sendCommand(CMD_VCOM_CDI);
+    sendData(0x80);             // BDZ=1, leave the border floating so it doesn't flash
+    sendData(0x07);             // CDI=10
+
+    sendCommand(CMD_PTIN);
+    sendCommand(CMD_PTL);
+    sendData(x >> 8);
+    sendData(x & 0xF8);
+    sendData((x + width - 1) >> 8);
+    sendData((x + width - 1) | 0x07);
+    sendData(y >> 8);
+    sendData(y & 0xFF);
+    sendData((y + height - 1) >> 8);
+    sendData((y + height - 1) & 0xFF);
+    sendData(0x01);             // Scan gates both inside and outside the window
+
+    if (upload(frameBuffer, x, y, width, height)) {
+        setLuts(LUT_VCOM_2BIT, LUT_WHITE_2BIT, LUT_LGREY_2BIT, LUT_DGREY_2BIT, LUT_BLACK_2BIT);
+    } else {
+        log_i("Window is black and white, using fast refresh");
+        setLuts(LUT_VCOM_FAST, LUT_WHITE_FAST, LUT_WHITE_FAST, LUT_BLACK_FAST, LUT_BLACK_FAST);
     }
 
     sendCommand(CMD_REFRESH);
     delay(100);
     waitUntilIdle();
+    sendCommand(CMD_PTOUT);
     sleep();
 }
 
 void DisplayGDEW075T7::fastClear(bool black)
 {
+    ProfilePhase phase(WakePhase::PANEL_REFRESH);
     wakeup();
 
-    setLut(CMD_SET_LUTVCOM, LUT_VCOM_FAST_CLEAR);
-    setLut(CMD_SET_LUTWW, black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR);
-    setLut(CMD_SET_LUTBW, black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR);
-    setLut(CMD_SET_LUTWB, black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR);
-    setLut(CMD_SET_LUTBB, black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR);
-    setLut(CMD_SET_LUTBD, black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR);
+    const uint8_t *lut = black ? LUT_BLACK_FAST_CLEAR : LUT_WHITE_FAST_CLEAR;
+    setLuts(LUT_VCOM_FAST_CLEAR, lut, lut, lut, lut);
 
     sendCommand(CMD_REFRESH);
     delay(100);
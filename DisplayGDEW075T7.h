@@ -18,11 +18,19 @@ public:
         uint8_t reset_pin,
         uint8_t dc_pin,
         uint8_t busy_pin,
-        uint8_t pwr_pin
+        uint8_t pwr_pin,
+        uint32_t spi_clock
     );
     ~DisplayGDEW075T7();
     void refresh(const FrameBuffer *frameBuffer);
+    void refresh(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void fastClear(bool black = false);
+    void setSpiClock(uint32_t clock);
+    inline uint32_t getSpiClock() const { return _spiClock; };
+    /**
+     * How long uploading the frame buffer took in the last call to refresh, in microseconds
+     */
+    inline uint32_t getLastUploadMicros() const { return _lastUploadMicros; };
 
 private:
     uint8_t _resetPin;
@@ -30,13 +38,19 @@ private:
     uint8_t _csPin;
     uint8_t _busyPin;
     uint8_t _pwrPin;
+    uint32_t _spiClock;
+    uint32_t _lastUploadMicros = 0;
     SPIClass *_spi;
 
     void wakeup();
     void sleep();
     void setLut(uint8_t cmd, const uint8_t* lut);
+    void setLuts(const uint8_t* vcom, const uint8_t* white, const uint8_t* lgrey, const uint8_t* dgrey, const uint8_t* black);
     void sendCommand(uint8_t command);
     void sendData(uint8_t data);
+    void sendData(const uint8_t *data, size_t length);
+    bool sendPlane(uint8_t command, const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    bool upload(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
     void waitUntilIdle();
 };
 
@@ -1,13 +1,114 @@
 #include <Arduino.h>
 #include <stdlib.h>
+#include <algorithm>
 #include "FrameBuffer.h"
-#include "Utf8Iterator.h"
+
+#ifdef FRAMEBUFFER_PROFILING
+#include <chrono>
+
+FrameBuffer::PrimitiveProfile FrameBuffer::profile[FrameBuffer::PRIMITIVE_COUNT];
+static uint8_t profileDepth = 0;
+
+void FrameBuffer::resetProfile()
+{
+    memset(profile, 0, sizeof(profile));
+}
+
+/**
+ * Adds the time until it goes out of scope to a primitive's profile, unless it's nested in another profiled call
+ */
+class ProfileScope
+{
+public:
+    inline ProfileScope(FrameBuffer::Primitive primitive) : _primitive(primitive)
+    {
+        if (profileDepth++ == 0) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    inline ~ProfileScope()
+    {
+        if (--profileDepth == 0) {
+            FrameBuffer::PrimitiveProfile &p = FrameBuffer::profile[_primitive];
+            ++p.calls;
+            p.nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+        }
+    }
+
+private:
+    FrameBuffer::Primitive _primitive;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#define PROFILE(primitive) ProfileScope profileScope(FrameBuffer::primitive)
+#else
+#define PROFILE(primitive)
+#endif
+
+/**
+ * Native pixel index of (x, y) in rotated coordinates, and how far that index moves for each step along the rotated x and y axes.
+ * These are resolved at compile time so the blitters below have no per-pixel rotation logic.
+ */
+template<FrameBuffer::Rotation R>
+static inline ptrdiff_t nativeIndex(int32_t x, int32_t y, ptrdiff_t nativeWidth, ptrdiff_t nativeHeight)
+{
+    switch (R) {
+        case FrameBuffer::ROTATION_90:
+            return nativeWidth * x + nativeWidth - 1 - y;
+        case FrameBuffer::ROTATION_180:
+            return nativeWidth * (nativeHeight - 1 - y) + nativeWidth - 1 - x;
+        case FrameBuffer::ROTATION_270:
+            return nativeWidth * (nativeHeight - 1 - x) + y;
+        default:
+            return nativeWidth * y + x;
+    }
+}
+
+template<FrameBuffer::Rotation R>
+static inline ptrdiff_t nativeStepX(ptrdiff_t nativeWidth)
+{
+    switch (R) {
+        case FrameBuffer::ROTATION_90:
+            return nativeWidth;
+        case FrameBuffer::ROTATION_180:
+            return -1;
+        case FrameBuffer::ROTATION_270:
+            return -nativeWidth;
+        default:
+            return 1;
+    }
+}
+
+template<FrameBuffer::Rotation R>
+static inline ptrdiff_t nativeStepY(ptrdiff_t nativeWidth)
+{
+    switch (R) {
+        case FrameBuffer::ROTATION_90:
+            return -1;
+        case FrameBuffer::ROTATION_180:
+            return -nativeWidth;
+        case FrameBuffer::ROTATION_270:
+            return 1;
+        default:
+            return nativeWidth;
+    }
+}
+
+static inline void setNativePx(uint8_t *data, size_t i, uint8_t color)
+{
+    uint8_t *fb = &data[i / 4];
+    const uint8_t shift = (3 - i % 4) * 2;
+    *fb = (*fb & ~(0b11 << shift)) | ((color & 0b11) << shift);
+}
 
 FrameBuffer::FrameBuffer(uint32_t nativeWidth, uint32_t nativeHeight)
 {
     _nativeWidth = nativeWidth;
     _nativeHeight = nativeHeight;
     _length = nativeWidth * nativeHeight / 4;
+    _tileColumns = (nativeWidth + TILE_WIDTH - 1) / TILE_WIDTH;
+    _dirtyTiles.resize(getTileCount(nativeWidth, nativeHeight));
 
     setRotation(ROTATION_0);
     setAlpha(NO_ALPHA);
@@ -23,7 +124,38 @@ FrameBuffer::~FrameBuffer()
 
 void FrameBuffer::clear(Color color)
 {
+    PROFILE(PRIMITIVE_CLEAR);
     memset(data, (color << 6) | (color << 4) | (color << 2) | color, _length);
+    std::fill(_dirtyTiles.begin(), _dirtyTiles.end(), false);
+}
+
+void FrameBuffer::getTileRect(size_t tile, uint32_t *x, uint32_t *y, uint32_t *width, uint32_t *height) const
+{
+    *x = tile % _tileColumns * TILE_WIDTH;
+    *y = tile / _tileColumns * TILE_HEIGHT;
+    *width = _nativeWidth - *x < TILE_WIDTH ? _nativeWidth - *x : TILE_WIDTH;
+    *height = _nativeHeight - *y < TILE_HEIGHT ? _nativeHeight - *y : TILE_HEIGHT;
+}
+
+/**
+ * Marks the tiles under a rectangle in rotated coordinates as dirty
+ */
+void FrameBuffer::markDirty(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    if (getNativeRect(&x, &y, &width, &height)) {
+        markNativeDirty(x, y, width, height);
+    }
+}
+
+void FrameBuffer::markNativeDirty(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    const uint32_t lastColumn = (x + width - 1) / TILE_WIDTH;
+    const uint32_t lastRow = (y + height - 1) / TILE_HEIGHT;
+    for (uint32_t row = y / TILE_HEIGHT; row <= lastRow; ++row) {
+        for (uint32_t column = x / TILE_WIDTH; column <= lastColumn; ++column) {
+            _dirtyTiles[row * _tileColumns + column] = true;
+        }
+    }
 }
 
 void FrameBuffer::test()
@@ -48,6 +180,7 @@ void FrameBuffer::test()
         (WHITE << 6) | (WHITE << 4) | (WHITE << 2) | WHITE,
         _length / 4
     );
+    std::fill(_dirtyTiles.begin(), _dirtyTiles.end(), true);
 }
 
 size_t FrameBuffer::getPixelIndex(int32_t x, int32_t y) const
@@ -88,126 +221,186 @@ void FrameBuffer::setPx(int32_t x, int32_t y, Color color)
 {
     const size_t i = getPixelIndex(x, y);
     if (i != SIZE_MAX) {
-        uint8_t *fb = &data[i / 4];
-        const uint8_t shift = (3 - i % 4) * 2;
-        *fb &= ~(0b11 << shift);
-        *fb |= (color & 0b11) << shift;
+        setNativePx(data, i, color);
+        markNativeDirty(i % _nativeWidth, i / _nativeWidth, 1, 1);
+    }
+}
+
+/**
+ * Fills length pixels along the rotated x axis starting at native pixel index start. In rotations where that axis is a native
+ * row this is a byte fill, otherwise each pixel is in a different row and is set individually.
+ */
+template<FrameBuffer::Rotation R>
+void FrameBuffer::fillNativeSpan(ptrdiff_t start, uint16_t length, Color color)
+{
+    switch (R) {
+        case ROTATION_0:
+            fillNativeRow(start, length, color);
+            break;
+        case ROTATION_180:
+            fillNativeRow(start + 1 - length, length, color);
+            break;
+        default: {
+            const ptrdiff_t step = nativeStepX<R>(_nativeWidth);
+            for (; length > 0; --length, start += step) {
+                setNativePx(data, start, color);
+            }
+            break;
+        }
     }
 }
 
 void FrameBuffer::drawImage(const Image &image, int32_t x, int32_t y, Align align)
 {
-    ImageReader reader = ImageReader(image);
+    PROFILE(PRIMITIVE_IMAGE);
     adjustAlignment(&x, &y, image.width, image.height, align);
+    const bool alpha = _alpha <= BLACK;
+
+    switch (_rotation) {
+        case ROTATION_90:
+            alpha ? blitImage<ROTATION_90, true>(image, x, y) : blitImage<ROTATION_90, false>(image, x, y);
+            break;
+        case ROTATION_180:
+            alpha ? blitImage<ROTATION_180, true>(image, x, y) : blitImage<ROTATION_180, false>(image, x, y);
+            break;
+        case ROTATION_270:
+            alpha ? blitImage<ROTATION_270, true>(image, x, y) : blitImage<ROTATION_270, false>(image, x, y);
+            break;
+        default:
+            alpha ? blitImage<ROTATION_0, true>(image, x, y) : blitImage<ROTATION_0, false>(image, x, y);
+            break;
+    }
+}
+
+template<FrameBuffer::Rotation R, bool ALPHA>
+void FrameBuffer::blitImage(const Image &image, int32_t x, int32_t y)
+{
+    int32_t left = x, top = y, width = image.width, height = image.height;
+    if (!clipRect(&left, &top, &width, &height)) {
+        return;
+    }
+    // Visible part of the image in source coordinates
+    const int32_t xStart = left - x, xEnd = xStart + width;
+    const int32_t yStart = top - y, yEnd = yStart + height;
+    const ptrdiff_t stepX = nativeStepX<R>(_nativeWidth);
+    const ptrdiff_t stepY = nativeStepY<R>(_nativeWidth);
 
-    Color color;
-    uint32_t y_dst;
+    markDirty(left, top, width, height);
 
-    for (uint32_t y_src = 0; y_src < image.height; ++y_src) {
-        y_dst = y + y_src;
-        for (uint32_t x_src = 0; x_src < image.width; ++x_src) {
-            color = static_cast<Color>(reader.next());    
-            if (color != _alpha) {
-                setPx(x + x_src, y_dst, color);
+    ImageReader reader = ImageReader(image);
+    reader.skip(yStart * image.width);
+
+    ptrdiff_t row = nativeIndex<R>(left, top, _nativeWidth, _nativeHeight);
+    for (int32_t y_src = yStart; y_src < yEnd; ++y_src, row += stepY) {
+        reader.skip(xStart);
+        ptrdiff_t i = row;
+        // Runs can cross row boundaries, so they're split at the edge of the visible area and the rest is picked up on the next row
+        for (int32_t x_src = xStart; x_src < xEnd;) {
+            uint8_t color;
+            const uint16_t length = reader.nextRun(color, xEnd - x_src);
+            if (!ALPHA || color != _alpha) {
+                fillNativeSpan<R>(i, length, static_cast<Color>(color));
             }
+            x_src += length;
+            i += stepX * length;
         }
+        reader.skip(image.width - xEnd);
     }
 }
 
 uint32_t FrameBuffer::measureText(String str, const Font &font, int32_t tracking)
 {
-    if (str.length() == 0) {
+    PROFILE(PRIMITIVE_TEXT);
+    return measureText(GlyphRun(str, font), tracking);
+}
+
+uint32_t FrameBuffer::measureText(const GlyphRun &run, int32_t tracking)
+{
+    PROFILE(PRIMITIVE_TEXT);
+    if (run.size() == 0) {
         return 0;
     }
 
     uint32_t length = 0;
-    Utf8Iterator it = Utf8Iterator(str);
-    uint16_t cp;
-    while ((cp = it.next())) {
-        if (Utf8Iterator::isSpaceCodePoint(cp)) {
-            length += font.spaceWidth + tracking;
-        } else {
-            const FontGlyph glyph = font.getGlyph(cp);
-            length += glyph.width + glyph.left + tracking;
-        }
+    for (size_t i = 0; i < run.size(); ++i) {
+        length += run.getAdvance(i) + tracking;
     }
     return length - tracking;
 }
 
-std::vector<String> FrameBuffer::wordWrap(String str, const Font &font, uint32_t maxLineLength, int32_t tracking)
+std::vector<GlyphRun> FrameBuffer::wordWrap(const GlyphRun &run, uint32_t maxLineLength, int32_t tracking)
 {
-    std::vector<String> lines;
-
-    if (str.length() == 0) {
-        return lines;
-    }
+    PROFILE(PRIMITIVE_TEXT);
+    std::vector<GlyphRun> lines;
 
-    unsigned int lineStart = 0, safeLineEnd = 0;
+    // Line boundaries are indices into the run. safeLineEnd is the index after the last space, so the line that
+    // gets wrapped there ends at safeLineEnd - 1 to leave out the space.
+    size_t lineStart = 0, safeLineEnd = 0;
     uint32_t length = 0, safeLength = 0;
-    Utf8Iterator it = Utf8Iterator(str);
-    uint16_t cp;
 
-    while ((cp = it.next())) {
-        if (Utf8Iterator::isNewlineCodePoint(cp)) {
-            if (maxLineLength > 0 && length > maxLineLength + tracking) {
-                // Wrap at the last word too
-                lines.push_back(str.substring(lineStart, safeLineEnd - 1));
+    for (size_t i = 0; i < run.size(); ++i) {
+        if (run[i].newline) {
+            if (maxLineLength > 0 && length > maxLineLength + tracking && safeLineEnd > lineStart) {
+                // Wrap at the last word too, unless the line is a single word that cannot be wrapped
+                lines.push_back(GlyphRun(run, lineStart, safeLineEnd - 1));
                 lineStart = safeLineEnd;
             }
             // Wrap here
-            lines.push_back(str.substring(lineStart, it.getCurrentPosition() - 1));
-            lineStart = safeLineEnd = it.getCurrentPosition();
+            lines.push_back(GlyphRun(run, lineStart, i));
+            lineStart = safeLineEnd = i + 1;
             length = safeLength = 0;
-        } else if (Utf8Iterator::isSpaceCodePoint(cp)) {
+        } else if (!run[i].glyph) {
             if (maxLineLength > 0 && length > maxLineLength + tracking) {
                 if (safeLineEnd == lineStart) {
                     // Line cannot be word wrapped, so wrap at current position
-                    lines.push_back(str.substring(lineStart, it.getCurrentPosition() - 1));
-                    lineStart = it.getCurrentPosition();
+                    lines.push_back(GlyphRun(run, lineStart, i));
+                    lineStart = i + 1;
                     length = 0;
                 } else {
                     // Wrap at last word
-                    lines.push_back(str.substring(lineStart, safeLineEnd - 1));
+                    lines.push_back(GlyphRun(run, lineStart, safeLineEnd - 1));
                     lineStart = safeLineEnd;
                     length -= safeLength;
                 }
             } else {
-                length += font.spaceWidth + tracking;
+                length += run.getAdvance(i) + tracking;
             }
-            safeLineEnd = it.getCurrentPosition();
+            safeLineEnd = i + 1;
             safeLength = length;
         } else {
-            const FontGlyph glyph = font.getGlyph(cp);
-            length += glyph.width + glyph.left + tracking;
+            length += run.getAdvance(i) + tracking;
         }
     }
-    if (lineStart < str.length()) {
-        lines.push_back(str.substring(lineStart));
+    if (lineStart < run.size()) {
+        lines.push_back(GlyphRun(run, lineStart, run.size()));
     }
     return lines;
 }
 
 void FrameBuffer::drawText(String str, const Font &font, int32_t x, int32_t y, Align align, int32_t tracking)
 {
+    PROFILE(PRIMITIVE_TEXT);
+    drawText(GlyphRun(str, font), x, y, align, tracking);
+}
+
+void FrameBuffer::drawText(const GlyphRun &run, int32_t x, int32_t y, Align align, int32_t tracking)
+{
+    PROFILE(PRIMITIVE_TEXT);
+    const Font &font = run.getFont();
     if (align != TOP_LEFT) {
         uint32_t width;
         // Measurement isn't needed and width isn't used by adjustAligment if horizontal alignment is left
         if (!(align & _ALIGN_LEFT)) {
-            width = measureText(str, font);
+            width = measureText(run);
         }
         adjustAlignment(&x, &y, width, font.ascent + font.descent, align);
     }
-    Utf8Iterator it = Utf8Iterator(str);
-    uint16_t cp;
-    while ((cp = it.next())) {
-        if (Utf8Iterator::isSpaceCodePoint(cp)) {
-            x += font.spaceWidth + tracking;
-        } else {
-            const FontGlyph glyph = font.getGlyph(cp);
-            x += glyph.left;
-            drawImage(glyph, x, y + glyph.top);
-            x += glyph.width + tracking;
+    for (size_t i = 0; i < run.size(); ++i) {
+        const FontGlyph *glyph = run[i].glyph;
+        if (glyph) {
+            drawImage(*glyph, x + glyph->left, y + glyph->top);
         }
+        x += run.getAdvance(i) + tracking;
     }
 }
 
@@ -221,10 +414,11 @@ void FrameBuffer::drawMultilineText(
     int32_t tracking,
     int32_t leading
 ) {
+    PROFILE(PRIMITIVE_TEXT);
     // This implementation is simple because it assumes justification equals the horizontal alignment,
     // and that's all I needed it to do.
     leading += font.ascent + font.descent;
-    std::vector<String> lines = wordWrap(str, font, maxLineLength, tracking);
+    std::vector<GlyphRun> lines = wordWrap(GlyphRun(str, font), maxLineLength, tracking);
 
     if (!(align & _ALIGN_TOP)) {
         adjustAlignment(&x, &y, 0, leading * lines.size(), align);
@@ -232,61 +426,82 @@ void FrameBuffer::drawMultilineText(
 
     // Use top alignment for each line since that axis has already been adjusted for the whole block
     align = (Align)(align & ~_ALIGN_BOTTOM & ~_ALIGN_VCENTER | _ALIGN_TOP);
-    for (String str : lines) {
-        drawText(str, font, x, y, align, tracking);
+    for (const GlyphRun &line : lines) {
+        drawText(line, x, y, align, tracking);
         y += leading;
     }
 }
 
-void FrameBuffer::drawQrCode(qrcodegen::QrCode qrcode, int32_t x, int32_t y, int32_t scale, Align align)
+void FrameBuffer::drawQrCode(const qrcodegen::QrCode &qrcode, int32_t x, int32_t y, int32_t scale, Align align)
 {
+    PROFILE(PRIMITIVE_QR_CODE);
     const int32_t size = qrcode.getSize() * scale;
     adjustAlignment(&x, &y, size, size, align);
 
-    Color color;
-    int32_t y2;
-    for(int y1 = 0; y1 < size; ++y1) {
-        y2 = y1 / scale;
-        for (int x1 = 0; x1 < size; ++x1) {
-            setPx(x + x1, y + y1, qrcode.getModule(x1 / scale, y2) ? BLACK : WHITE);
+    switch (_rotation) {
+        case ROTATION_90:
+            blitQrCode<ROTATION_90>(qrcode, x, y, scale);
+            break;
+        case ROTATION_180:
+            blitQrCode<ROTATION_180>(qrcode, x, y, scale);
+            break;
+        case ROTATION_270:
+            blitQrCode<ROTATION_270>(qrcode, x, y, scale);
+            break;
+        default:
+            blitQrCode<ROTATION_0>(qrcode, x, y, scale);
+            break;
+    }
+}
+
+template<FrameBuffer::Rotation R>
+void FrameBuffer::blitQrCode(const qrcodegen::QrCode &qrcode, int32_t x, int32_t y, int32_t scale)
+{
+    int32_t left = x, top = y, width = qrcode.getSize() * scale, height = width;
+    if (!clipRect(&left, &top, &width, &height)) {
+        return;
+    }
+    const int32_t xStart = left - x, xEnd = xStart + width;
+    const int32_t yStart = top - y, yEnd = yStart + height;
+    const ptrdiff_t stepX = nativeStepX<R>(_nativeWidth);
+    const ptrdiff_t stepY = nativeStepY<R>(_nativeWidth);
+    markDirty(left, top, width, height);
+
+    ptrdiff_t row = nativeIndex<R>(left, top, _nativeWidth, _nativeHeight);
+    for (int32_t y1 = yStart; y1 < yEnd; ++y1, row += stepY) {
+        const int32_t y2 = y1 / scale;
+        ptrdiff_t i = row;
+        for (int32_t x1 = xStart; x1 < xEnd; ++x1, i += stepX) {
+            setNativePx(data, i, qrcode.getModule(x1 / scale, y2) ? BLACK : WHITE);
         }
     }
 }
 
 void FrameBuffer::drawHLine(int32_t x, int32_t y, int32_t length, uint32_t thickness, Color color, Align align)
 {
+    PROFILE(PRIMITIVE_FILL);
     if (length < 0) {
         x += length;
         length = -length;
     }
     adjustAlignment(&x, &y, length, thickness, align);
-    const int32_t ymax = y + thickness;
-    int32_t i, y1;
-    for (i = 0; i < length; ++i) {
-        for (y1 = y; y1 < ymax; ++y1) {
-            setPx(x + i, y1, color);
-        }
-    }
+    fillClippedRect(x, y, length, thickness, color);
 }
 
 void FrameBuffer::drawVLine(int32_t x, int32_t y, int32_t length, uint32_t thickness, Color color, Align align)
 {
+    PROFILE(PRIMITIVE_FILL);
     if (length < 0) {
         y += length;
         length = -length;
     }
     adjustAlignment(&x, &y, thickness, length, align);
-    const int32_t xmax = x + thickness;
-    int32_t i, x1;
-    for (i = 0; i < length; ++i) {
-        for (x1 = x; x1 < xmax; ++x1) {
-            setPx(x1, y + i, color);
-        }
-    }
+    fillClippedRect(x, y, thickness, length, color);
 }
 
 void FrameBuffer::fillRect(int32_t x, int32_t y, int32_t width, int32_t height, Color color, Align align)
 {
+    PROFILE(PRIMITIVE_FILL);
     if (width < 0) {
         x += width;
         width = -width;
@@ -296,16 +511,12 @@ void FrameBuffer::fillRect(int32_t x, int32_t y, int32_t width, int32_t height,
         height = -height;
     }
     adjustAlignment(&x, &y, width, height, align);
-    int32_t x2 = x + width, y2 = y + height;
-    for (int xi = x; xi < x2; ++xi) {
-        for (int yi = y; yi < y2; ++yi) {
-            setPx(xi, yi, color);
-        }
-    }
+    fillClippedRect(x, y, width, height, color);
 }
 
 void FrameBuffer::strokeRect(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t strokeWidth, Color color, bool strokeOutside, Align align)
 {
+    PROFILE(PRIMITIVE_FILL);
     if (width < 0) {
         x += width;
         width = -width;
@@ -342,6 +553,109 @@ void FrameBuffer::adjustAlignment(int32_t *x, int32_t *y, int32_t width, int32_t
     }
 }
 
+/**
+ * Clips a rectangle in rotated coordinates to the visible area, returning false if nothing is left to draw
+ */
+bool FrameBuffer::clipRect(int32_t *x, int32_t *y, int32_t *width, int32_t *height) const
+{
+    if (*x < 0) {
+        *width += *x;
+        *x = 0;
+    }
+    if (*y < 0) {
+        *height += *y;
+        *y = 0;
+    }
+    *width = min(*width, (int32_t)_width - *x);
+    *height = min(*height, (int32_t)_height - *y);
+    return *width > 0 && *height > 0;
+}
+
+/**
+ * Clips a rectangle in rotated coordinates and converts it in place to the same rectangle in native coordinates.
+ * Returns false if nothing is left after clipping.
+ */
+bool FrameBuffer::getNativeRect(int32_t *x, int32_t *y, int32_t *width, int32_t *height) const
+{
+    if (!clipRect(x, y, width, height)) {
+        return false;
+    }
+    const int32_t left = *x, top = *y, w = *width, h = *height;
+    switch (_rotation) {
+        case ROTATION_90:
+            *x = _nativeWidth - top - h;
+            *y = left;
+            *width = h;
+            *height = w;
+            break;
+        case ROTATION_180:
+            *x = _nativeWidth - left - w;
+            *y = _nativeHeight - top - h;
+            break;
+        case ROTATION_270:
+            *x = top;
+            *y = _nativeHeight - left - w;
+            *width = h;
+            *height = w;
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+/**
+ * Fills a rectangle in rotated coordinates by clipping it once and mapping it to a single rectangle in native coordinates,
+ * instead of going through getPixelIndex for every pixel.
+ */
+void FrameBuffer::fillClippedRect(int32_t x, int32_t y, int32_t width, int32_t height, Color color)
+{
+    if (getNativeRect(&x, &y, &width, &height)) {
+        fillNativeRect(x, y, width, height, color);
+        markNativeDirty(x, y, width, height);
+    }
+}
+
+/**
+ * Fills an already clipped rectangle in native coordinates one row at a time with fillNativeRow.
+ */
+void FrameBuffer::fillNativeRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, Color color)
+{
+    const uint32_t yEnd = y + height;
+    for (; y < yEnd; ++y) {
+        fillNativeRow(_nativeWidth * y + x, width, color);
+    }
+}
+
+/**
+ * Fills length pixels in native order starting at native pixel index start, masking the partial bytes
+ * at either end and using memset for everything in between.
+ */
+void FrameBuffer::fillNativeRow(size_t start, size_t length, Color color)
+{
+    const uint8_t fill = (color & 0b11) * 0b01010101;
+    const size_t end = start + length;
+    uint8_t *first = &data[start / 4];
+    uint8_t *last = &data[end / 4];
+    // Masks for the pixels being filled in the first and last byte
+    const uint8_t firstMask = 0xFF >> (start % 4 * 2);
+    const uint8_t lastMask = ~(0xFF >> (end % 4 * 2));
+
+    if (first == last) {
+        const uint8_t mask = firstMask & lastMask;
+        *first = (*first & ~mask) | (fill & mask);
+        return;
+    }
+    if (firstMask != 0xFF) {
+        *first = (*first & ~firstMask) | (fill & firstMask);
+        ++first;
+    }
+    memset(first, fill, last - first);
+    if (lastMask) {
+        *last = (*last & ~lastMask) | (fill & lastMask);
+    }
+}
+
 void FrameBuffer::setRotation(Rotation rotation)
 {
     _rotation = rotation;
@@ -3,6 +3,7 @@
 #include <utility>
 #include <vector>
 #include "qrcodegen.h"
+#include "GlyphRun.h"
 #include "resources/image.h"
 #include "resources/font/font.h"
 
@@ -22,6 +23,20 @@ private:
 public:
     static const uint8_t NO_ALPHA = 0b100;
 
+    /**
+     * Size of the tiles used to track which parts of the frame buffer have been drawn on, in native pixels
+     */
+    static const uint32_t TILE_WIDTH = 80;
+    static const uint32_t TILE_HEIGHT = 48;
+
+    /**
+     * Number of tiles covering a frame buffer of the given native size, including partial tiles at the edges
+     */
+    static constexpr size_t getTileCount(uint32_t nativeWidth, uint32_t nativeHeight)
+    {
+        return (size_t)((nativeWidth + TILE_WIDTH - 1) / TILE_WIDTH) * ((nativeHeight + TILE_HEIGHT - 1) / TILE_HEIGHT);
+    }
+
     enum Rotation: uint8_t {
         ROTATION_0,
         ROTATION_90,
@@ -48,8 +63,38 @@ public:
         BLACK = 0b11,
     };
 
+    #ifdef FRAMEBUFFER_PROFILING
+    enum Primitive: uint8_t {
+        PRIMITIVE_CLEAR,
+        PRIMITIVE_TEXT,
+        PRIMITIVE_IMAGE,
+        PRIMITIVE_FILL,
+        PRIMITIVE_QR_CODE,
+        PRIMITIVE_COUNT,
+    };
+
+    struct PrimitiveProfile {
+        uint32_t calls;
+        uint64_t nanos;
+    };
+
+    /**
+     * Time spent in each kind of drawing call since the last resetProfile(), across all frame buffers. Calls made
+     * from inside another drawing call, like the glyphs drawn by drawText, count towards the outer call only.
+     */
+    static PrimitiveProfile profile[PRIMITIVE_COUNT];
+    static void resetProfile();
+    #endif
+
     uint8_t *data;
     inline size_t getLength() const { return _length; }
+    /**
+     * A tile is dirty if anything has been drawn on it since the last clear(). Tiles that aren't dirty are still
+     * entirely the clear color. Writes made directly through data aren't tracked.
+     */
+    inline size_t getTileCount() const { return _dirtyTiles.size(); };
+    inline bool isTileDirty(size_t tile) const { return _dirtyTiles[tile]; };
+    void getTileRect(size_t tile, uint32_t *x, uint32_t *y, uint32_t *width, uint32_t *height) const;
 
     FrameBuffer(uint32_t nativeWidth, uint32_t nativeHeight);
     ~FrameBuffer();
@@ -60,13 +105,15 @@ public:
     inline uint32_t getHeight() const { return _height; };
     inline Rotation getRotation() const { return _rotation; };
     void setRotation(Rotation rotation);
-    inline uint8_t getAlpha() const { return _rotation; };
+    inline uint8_t getAlpha() const { return _alpha; };
     void setAlpha(uint8_t alpha);
+    bool getNativeRect(int32_t *x, int32_t *y, int32_t *width, int32_t *height) const;
     uint8_t getPx(int32_t x, int32_t y) const;
     void setPx(int32_t x, int32_t y, Color color);
     void drawImage(const Image &image, int32_t x, int32_t y, Align align = TOP_LEFT);
     uint32_t measureText(String str, const Font &font, int32_t tracking = 0);
-    std::vector<String> wordWrap(String str, const Font &font, uint32_t maxLineLength, int32_t tracking = 0);
+    uint32_t measureText(const GlyphRun &run, int32_t tracking = 0);
+    std::vector<GlyphRun> wordWrap(const GlyphRun &run, uint32_t maxLineLength, int32_t tracking = 0);
     void drawText(
         String str,
         const Font &font,
@@ -75,6 +122,7 @@ public:
         Align align = TOP_LEFT,
         int32_t tracking = 0
     );
+    void drawText(const GlyphRun &run, int32_t x, int32_t y, Align align = TOP_LEFT, int32_t tracking = 0);
     void drawMultilineText(
         String str,
         const Font &font,
@@ -85,7 +133,7 @@ public:
         int32_t tracking = 0,
         int32_t leading = 0
     );
-    void drawQrCode(qrcodegen::QrCode qrcode, int32_t x, int32_t y, int32_t scale = 1, Align align = TOP_LEFT);
+    void drawQrCode(const qrcodegen::QrCode &qrcode, int32_t x, int32_t y, int32_t scale = 1, Align align = TOP_LEFT);
     void drawVLine(int32_t x, int32_t y, int32_t length, uint32_t thickness, Color color, Align align = TOP_CENTER);
     void drawHLine(int32_t x, int32_t y, int32_t length, uint32_t thickness, Color color, Align align = LEFT_CENTER);
     void fillRect(int32_t x, int32_t y, int32_t width, int32_t height, Color color, Align align = TOP_LEFT);
@@ -108,9 +156,20 @@ private:
     uint32_t _height;
     uint8_t _alpha;
     Rotation _rotation;
+    uint32_t _tileColumns;
+    std::vector<bool> _dirtyTiles;
 
     static void adjustAlignment(int32_t *x, int32_t *y, int32_t width, int32_t height, Align align);
     size_t getPixelIndex(int32_t x, int32_t y) const;
+    bool clipRect(int32_t *x, int32_t *y, int32_t *width, int32_t *height) const;
+    void markDirty(int32_t x, int32_t y, int32_t width, int32_t height);
+    void markNativeDirty(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void fillClippedRect(int32_t x, int32_t y, int32_t width, int32_t height, Color color);
+    void fillNativeRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height, Color color);
+    void fillNativeRow(size_t start, size_t length, Color color);
+    template<Rotation R> void fillNativeSpan(ptrdiff_t start, uint16_t length, Color color);
+    template<Rotation R, bool ALPHA> void blitImage(const Image &image, int32_t x, int32_t y);
+    template<Rotation R> void blitQrCode(const qrcodegen::QrCode &qrcode, int32_t x, int32_t y, int32_t scale);
 };
 
 #endif // PORTALCALENDAR_FRAMEBUFFER_H
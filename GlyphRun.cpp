@@ -0,0 +1,22 @@
+#include "GlyphRun.h"
+#include "Utf8Iterator.h"
+
+GlyphRun::GlyphRun(String str, const Font &font): _font(&font)
+{
+    // Every code point is at least one byte, so this is enough to avoid reallocating
+    _entries.reserve(str.length());
+    Utf8Iterator it = Utf8Iterator(str);
+    uint16_t cp;
+    while ((cp = it.next())) {
+        if (Utf8Iterator::isSpaceCodePoint(cp)) {
+            _entries.push_back({ .glyph=nullptr, .newline=false });
+        } else {
+            _entries.push_back({ .glyph=&font.getGlyph(cp), .newline=Utf8Iterator::isNewlineCodePoint(cp) });
+        }
+    }
+}
+
+GlyphRun::GlyphRun(const GlyphRun &run, size_t start, size_t end):
+    _font(run._font),
+    _entries(run._entries.begin() + start, run._entries.begin() + end)
+{ }
@@ -0,0 +1,45 @@
+#include <Arduino.h>
+#include <vector>
+#include "resources/font/font.h"
+
+#ifndef PORTALCALENDAR_GLYPHRUN_H
+#define PORTALCALENDAR_GLYPHRUN_H
+
+/**
+ * A UTF-8 string resolved to the glyphs of a font.
+ *
+ * Each glyph is looked up once when the run is created, so the same run can then be measured,
+ * word wrapped and drawn without decoding the string or searching the font again.
+ */
+class GlyphRun
+{
+public:
+    struct Entry {
+        /**
+         * Glyph to draw, or nullptr for a space
+         */
+        const FontGlyph *glyph;
+        bool newline;
+    };
+
+    GlyphRun(String str, const Font &font);
+    /**
+     * Creates a run from the entries [start, end) of another run
+     */
+    GlyphRun(const GlyphRun &run, size_t start, size_t end);
+
+    inline const Font& getFont() const { return *_font; };
+    inline size_t size() const { return _entries.size(); };
+    inline const Entry& operator[](size_t i) const { return _entries[i]; };
+    inline uint32_t getAdvance(size_t i) const
+    {
+        const FontGlyph *glyph = _entries[i].glyph;
+        return glyph ? glyph->left + glyph->width : _font->spaceWidth;
+    };
+
+private:
+    const Font *_font;
+    std::vector<Entry> _entries;
+};
+
+#endif // PORTALCALENDAR_GLYPHRUN_H
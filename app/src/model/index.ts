@@ -35,6 +35,8 @@ export interface Preferences {
     weatherUnits: WeatherUnits;
     weatherStartHr: number;
     show24Hr: boolean;
+    spiClock: number;
+    batteryMah: number;
 }
 
 export interface WifiScanResponse {
@@ -45,12 +45,22 @@ enum class WeatherSecondaryInfo : uint8_t
 #define DEFAULT_2_NTP_SYNCS_PER_DAY true
 #define DEFAULT_MAX_RTC_CORRECTION_FACTOR 0.025
 
+#define DEFAULT_SPI_CLOCK_HZ 7000000
+
+#define DEFAULT_BATTERY_CAPACITY_MAH 1000
+
 /**
- * How long we'll wait for an NTP sync before giving up.
- * This is PER SERVER, so if there's no internet connection and 3 servers, the total timeout will be 3x this amount.
+ * How long we'll wait for an NTP sync before giving up. All servers are queried at the same time, so this is the
+ * total timeout no matter how many there are.
  */
 #define NTP_TIMEOUT_SECONDS 5
 
+/**
+ * Once the first NTP reply comes in, how long we'll keep waiting for the other servers in case one of them has a
+ * shorter round trip, and so a more accurate time.
+ */
+#define NTP_COLLECT_WINDOW_MS 250
+
 /**
  * How long we'll wait for a timezone information lookup before giving up.
  * This is PER SERVER, so if there's no internet connection and 3 servers, the total timeout will be 3x this amount.
@@ -62,6 +72,24 @@ enum class WeatherSecondaryInfo : uint8_t
  */
 #define WIFI_CONNECTION_TIMEOUT_SECONDS 10
 
+/**
+ * After a full Wi-Fi connection, the access point, channel and IP address are kept so the next wakes can reconnect
+ * straight to that access point with the same address, skipping the scan and DHCP. This is the longest they're reused
+ * for. The address is only reused for half of the DHCP lease the router gave it, when the lease would normally be
+ * renewed, so it's never used after it could have been given to something else. After that, reconnects still go
+ * straight to the access point but get their address from DHCP, which renews it. If a fast reconnect doesn't succeed
+ * within the timeout, whether or not it uses DHCP, a full connection is made instead.
+ */
+#define WIFI_FAST_RECONNECT_MAX_AGE_HOURS 12
+#define WIFI_FAST_RECONNECT_TIMEOUT_SECONDS 2
+
+/**
+ * How long the timezone, NTP and weather syncs of one wake can take once Wi-Fi is connected. They run at the same time,
+ * and any that hasn't finished by then gives up and is retried on the next wake, unless the calendar can't show
+ * anything without it.
+ */
+#define NETWORK_SESSION_TIMEOUT_SECONDS 20
+
 /**
  * Controls how long before midnight the processor is woken up for the first and second NTP syncs.
  * 
@@ -100,10 +128,67 @@ enum class WeatherSecondaryInfo : uint8_t
 // #define AP_PASS "12345678"
 
 /**
- * Port assignments
+ * How many partial refreshes can happen in a row before a full refresh is forced. A partial refresh is done when only
+ * part of the screen changed since the last refresh, such as the weather during the day, and each one can leave a little
+ * ghosting behind.
+ */
+#define MAX_PARTIAL_REFRESHES 6
+
+/**
+ * Range allowed for the display SPI clock setting, and the clocks the config server offers to probe.
+ *
+ * The display controller is write-only on this board, so a probe can't read back what was sent. Instead each probe
+ * uploads a test pattern and reports the measured upload time, and the highest clock that still shows a clean pattern
+ * can be saved. Upload time is directly proportional to how long the ESP32 stays awake for each refresh.
+ */
+#define MIN_SPI_CLOCK_HZ 1000000
+#define MAX_SPI_CLOCK_HZ 20000000
+#define SPI_PROBE_CLOCKS_HZ { 4000000, 7000000, 10000000, 13333333, 16000000, 20000000 }
+
+/**
+ * How many of the most recent wakes to keep phase timings for in RTC memory. The config server shows them at /wake-profiles.
+ */
+#define WAKE_PROFILE_COUNT 16
+
+/**
+ * Range allowed for the battery capacity setting. With 4xAAA batteries in series this is the capacity of a single cell,
+ * which is around 1000mAh for alkalines and 800mAh for NiMH.
+ */
+#define MIN_BATTERY_CAPACITY_MAH 100
+#define MAX_BATTERY_CAPACITY_MAH 20000
+
+/**
+ * Current drawn from the batteries during each part of a wake, which is used to estimate battery usage from the wake
+ * phase timings. The config server shows the estimates at /diagnostics.
+ *
+ * The defaults are typical figures for the EzSBC board and the display driver board. For better estimates, measure
+ * your own with a multimeter in series with the batteries.
+ */
+#define ACTIVE_CURRENT_MA 45            // CPU running with Wi-Fi off
+#define WIFI_CURRENT_MA 120             // CPU running with Wi-Fi on, averaged over transmitting and receiving
+#define PANEL_REFRESH_CURRENT_MA 10     // CPU in light sleep while the panel refreshes
+#define DEEP_SLEEP_CURRENT_UA 25
+
+/**
+ * Stack size in bytes for the tasks that run the timezone, NTP and weather syncs at the same time
+ */
+#define BACKGROUND_TASK_STACK_SIZE 8192
+
+/**
+ * Where the weather is downloaded from, as host or host:port. Can be overridden with a build flag to test against
+ * native/mock_server.py instead, for example build_flags = -DOWM_API_HOST='"192.168.1.10:8080"'
+ */
+#ifndef OWM_API_HOST
+#define OWM_API_HOST "api.openweathermap.org"
+#endif
+
+/**
+ * Port assignments. The NTP and timezoned servers are contacted on these ports unless their names end in :port.
  */
 #define NTP_LOCAL_PORT_START 4242
 #define TIMEZONED_LOCAL_PORT_START 2342
+#define NTP_SERVER_PORT 123
+#define TIMEZONED_SERVER_PORT 2342
 
 /**
  * Pin assignments
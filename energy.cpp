@@ -0,0 +1,85 @@
+#include "energy.h"
+#include "Configuration.h"
+#include "time_util.h"
+
+#define uS_PER_HOUR (uS_PER_S * (double)SECONDS_PER_HOUR)
+
+RTC_DATA_ATTR EnergyTotals energyTotals = {};
+
+float getPhaseCurrentMa(WakePhase phase)
+{
+    switch (phase) {
+        case WakePhase::WIFI:
+        case WakePhase::NETWORK_SYNC:
+        case WakePhase::TZ_LOOKUP:
+        case WakePhase::NTP_SYNC:
+        case WakePhase::WEATHER_HTTP:
+        case WakePhase::WEATHER_PARSE:
+            return WIFI_CURRENT_MA;
+        case WakePhase::PANEL_REFRESH:
+            return PANEL_REFRESH_CURRENT_MA;
+        default:
+            return ACTIVE_CURRENT_MA;
+    }
+}
+
+void recordWakeEnergy(const WakeProfile& profile)
+{
+    if (!energyTotals.since) {
+        // Until the first NTP sync the clock starts at 1970, so counting only starts with a wake that began on a synced
+        // clock. Otherwise the totals would seem to cover decades and the projected battery life would be far too long.
+        if (!lastNtpSync || profile.wakeTime < lastNtpSync) {
+            return;
+        }
+        energyTotals.since = profile.wakeTime;
+    }
+    ++energyTotals.wakes;
+    for (size_t phase = 0; phase < WAKE_PHASE_COUNT; ++phase) {
+        energyTotals.phaseMah[phase] += getPhaseCurrentMa(static_cast<WakePhase>(phase)) * profile.phaseMicros[phase] / uS_PER_HOUR;
+    }
+}
+
+void recordSleepEnergy(uint32_t seconds)
+{
+    if (!energyTotals.since) {
+        return;
+    }
+    energyTotals.sleepSeconds += seconds;
+    energyTotals.sleepMah += DEEP_SLEEP_CURRENT_UA / 1000.0 * seconds / SECONDS_PER_HOUR;
+}
+
+void resetEnergyTotals()
+{
+    energyTotals = {};
+}
+
+const EnergyTotals& getEnergyTotals()
+{
+    return energyTotals;
+}
+
+double getUsedMah()
+{
+    double used = energyTotals.sleepMah;
+    for (size_t phase = 0; phase < WAKE_PHASE_COUNT; ++phase) {
+        used += energyTotals.phaseMah[phase];
+    }
+    return used;
+}
+
+float getRemainingBatteryDays(time_t now)
+{
+    if (!energyTotals.since || now - energyTotals.since < SECONDS_PER_DAY) {
+        return -1;
+    }
+    const double used = getUsedMah();
+    if (used <= 0) {
+        return -1;
+    }
+    const double remaining = Config.getBatteryCapacity() - used;
+    if (remaining <= 0) {
+        return 0;
+    }
+    const double usedPerDay = used * SECONDS_PER_DAY / (now - energyTotals.since);
+    return remaining / usedPerDay;
+}
@@ -0,0 +1,54 @@
+#include "global.h"
+#include "profiler.h"
+
+#ifndef PORTALCALENDAR_ENERGY_H
+#define PORTALCALENDAR_ENERGY_H
+
+/**
+ * Estimated battery usage since RTC memory was last cleared. That happens when the batteries are changed, but also when
+ * the RESET button is pressed or new firmware is flashed, so these are only accurate if the batteries were fresh then.
+ */
+struct EnergyTotals
+{
+    /**
+     * Time of the first wake that was counted, or 0 if nothing has been counted yet
+     */
+    time_t since;
+    uint32_t wakes;
+    uint32_t sleepSeconds;
+    double phaseMah[WAKE_PHASE_COUNT];
+    double sleepMah;
+};
+
+/**
+ * Estimated current draw during a wake phase, from the values in config.h
+ */
+float getPhaseCurrentMa(WakePhase phase);
+
+/**
+ * Estimates how much charge a finished wake used and adds it to the totals. Nothing is counted until there's been a
+ * wake that started after the clock was synced.
+ */
+void recordWakeEnergy(const WakeProfile& profile);
+
+/**
+ * Adds the charge used by a deep sleep that lasted the given number of seconds to the totals, if they've started
+ */
+void recordSleepEnergy(uint32_t seconds);
+
+void resetEnergyTotals();
+
+const EnergyTotals& getEnergyTotals();
+
+/**
+ * Total charge used by wakes and sleeps
+ */
+double getUsedMah();
+
+/**
+ * Estimates how many days the batteries will last at the average rate they've been used since the totals started.
+ * Returns -1 if there isn't at least a day of data yet.
+ */
+float getRemainingBatteryDays(time_t now);
+
+#endif // PORTALCALENDAR_ENERGY_H
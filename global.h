@@ -18,5 +18,7 @@
 #define TZ_LOOKUP_TIMEOUT_MS                    TZ_LOOKUP_TIMEOUT_SECONDS * 1000
 #define NTP_TIMEOUT_MS                          NTP_TIMEOUT_SECONDS * 1000
 #define WIFI_CONNECTION_TIMEOUT_MS              WIFI_CONNECTION_TIMEOUT_SECONDS * 1000
+#define WIFI_FAST_RECONNECT_TIMEOUT_MS          WIFI_FAST_RECONNECT_TIMEOUT_SECONDS * 1000
+#define NETWORK_SESSION_TIMEOUT_MS              NETWORK_SESSION_TIMEOUT_SECONDS * 1000
 
 #endif // PORTALCALENDAR_GLOBAL_H
@@ -0,0 +1,72 @@
+/**
+ * Native implementation of the GDEW075T7 driver. Instead of talking to the controller, every refresh copies
+ * the frame buffer (or the refreshed window of it) onto the simulated panel.
+ */
+
+#include "DisplayGDEW075T7.h"
+#include "NativePanel.h"
+
+DisplayGDEW075T7::~DisplayGDEW075T7() {};
+
+DisplayGDEW075T7::DisplayGDEW075T7(
+    uint8_t spi_bus,
+    uint8_t sck_pin,
+    uint8_t copi_pin,
+    uint8_t cs_pin,
+    uint8_t reset_pin,
+    uint8_t dc_pin,
+    uint8_t busy_pin,
+    uint8_t pwr_pin,
+    uint32_t spi_clock
+) {
+    _resetPin = reset_pin;
+    _dcPin = dc_pin;
+    _csPin = cs_pin;
+    _busyPin = busy_pin;
+    _pwrPin = pwr_pin;
+    _spiClock = spi_clock;
+    _spi = nullptr;
+};
+
+void DisplayGDEW075T7::setSpiClock(uint32_t clock)
+{
+    _spiClock = clock;
+}
+
+void DisplayGDEW075T7::refresh(const FrameBuffer *frameBuffer)
+{
+    unsigned long start = micros();
+    Panel.show(frameBuffer, 0, 0, NATIVE_WIDTH, NATIVE_HEIGHT);
+    _lastUploadMicros = micros() - start;
+}
+
+/**
+ * Clips the window the same way as the real driver, including widening it to a multiple of 8 pixels
+ */
+void DisplayGDEW075T7::refresh(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    width += x % 8;
+    x -= x % 8;
+    width = (width + 7) & ~7u;
+    if (x >= NATIVE_WIDTH || y >= NATIVE_HEIGHT) {
+        return;
+    }
+    if (x + width > NATIVE_WIDTH) {
+        width = NATIVE_WIDTH - x;
+    }
+    if (y + height > NATIVE_HEIGHT) {
+        height = NATIVE_HEIGHT - y;
+    }
+    if (!width || !height) {
+        return;
+    }
+
+    unsigned long start = micros();
+    Panel.show(frameBuffer, x, y, width, height);
+    _lastUploadMicros = micros() - start;
+}
+
+void DisplayGDEW075T7::fastClear(bool black)
+{
+    Panel.fill(black ? FrameBuffer::BLACK : FrameBuffer::WHITE);
+}
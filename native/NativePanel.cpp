@@ -0,0 +1,62 @@
+#include "NativePanel.h"
+#include "DisplayGDEW075T7.h"
+
+NativePanel Panel(DisplayGDEW075T7::NATIVE_WIDTH, DisplayGDEW075T7::NATIVE_HEIGHT);
+
+NativePanel::NativePanel(uint32_t nativeWidth, uint32_t nativeHeight) : _frameBuffer(nativeWidth, nativeHeight)
+{
+    _frameBuffer.setRotation(FrameBuffer::ROTATION_270);
+}
+
+void NativePanel::show(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    // Windows are always byte aligned, the driver widens them to a multiple of 8 pixels
+    const uint32_t nativeWidth = DisplayGDEW075T7::NATIVE_WIDTH;
+    for (uint32_t row = y; row < y + height; ++row) {
+        memcpy(&_frameBuffer.data[(row * nativeWidth + x) / 4], &frameBuffer->data[(row * nativeWidth + x) / 4], width / 4);
+    }
+    if (width == nativeWidth && height == DisplayGDEW075T7::NATIVE_HEIGHT) {
+        ++_fullRefreshCount;
+    } else {
+        ++_partialRefreshCount;
+    }
+}
+
+void NativePanel::fill(FrameBuffer::Color color)
+{
+    _frameBuffer.clear(color);
+}
+
+void NativePanel::reset()
+{
+    _frameBuffer.clear();
+    _fullRefreshCount = _partialRefreshCount = 0;
+}
+
+std::vector<uint8_t> NativePanel::getGreyscale() const
+{
+    static const uint8_t GREY_LEVELS[] = { 255, 170, 85, 0 };
+
+    const uint32_t width = _frameBuffer.getWidth();
+    const uint32_t height = _frameBuffer.getHeight();
+    std::vector<uint8_t> pixels(width * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            pixels[y * width + x] = GREY_LEVELS[_frameBuffer.getPx(x, y) & 0b11];
+        }
+    }
+    return pixels;
+}
+
+bool NativePanel::writePgm(const char *path) const
+{
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        log_e("Cannot open %s for writing", path);
+        return false;
+    }
+    const std::vector<uint8_t> pixels = getGreyscale();
+    fprintf(file, "P5\n%u %u\n255\n", _frameBuffer.getWidth(), _frameBuffer.getHeight());
+    fwrite(pixels.data(), 1, pixels.size(), file);
+    return fclose(file) == 0;
+}
@@ -0,0 +1,40 @@
+#include "FrameBuffer.h"
+
+#ifndef PORTALCALENDAR_NATIVE_PANEL_H
+#define PORTALCALENDAR_NATIVE_PANEL_H
+
+/**
+ * Stands in for the e-paper panel when running natively. The native DisplayGDEW075T7 copies the refreshed window
+ * into it instead of sending it over SPI, so it holds exactly what the physical display would be showing.
+ */
+class NativePanel
+{
+public:
+    NativePanel(uint32_t nativeWidth, uint32_t nativeHeight);
+    void show(const FrameBuffer *frameBuffer, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void fill(FrameBuffer::Color color);
+    void reset();
+    /**
+     * 8-bit greyscale image of the panel rotated to how it's mounted in the frame, one byte per pixel
+     */
+    std::vector<uint8_t> getGreyscale() const;
+    /**
+     * Writes getGreyscale() as a binary PGM
+     */
+    bool writePgm(const char *path) const;
+    inline uint32_t getWidth() const { return _frameBuffer.getWidth(); };
+    inline uint32_t getHeight() const { return _frameBuffer.getHeight(); };
+    inline const uint8_t* getData() const { return _frameBuffer.data; };
+    inline size_t getLength() const { return _frameBuffer.getLength(); };
+    inline uint32_t getFullRefreshCount() const { return _fullRefreshCount; };
+    inline uint32_t getPartialRefreshCount() const { return _partialRefreshCount; };
+
+private:
+    FrameBuffer _frameBuffer;
+    uint32_t _fullRefreshCount = 0;
+    uint32_t _partialRefreshCount = 0;
+};
+
+extern NativePanel Panel;
+
+#endif // PORTALCALENDAR_NATIVE_PANEL_H
@@ -0,0 +1,160 @@
+/**
+ * Times every screen DisplayClass can draw and prints the results as JSON, so runs from different commits can be diffed.
+ *
+ * Each scenario is rendered once to warm up, then timed for the requested number of iterations. Times include
+ * everything the firmware does for that screen (reading settings, drawing, hashing tiles and the simulated refresh),
+ * with a breakdown of how much of it went to each kind of FrameBuffer primitive.
+ */
+
+#include "Display.h"
+#include "Configuration.h"
+#include "time_util.h"
+#include "simulator.h"
+#include "scenarios.h"
+
+#ifndef FRAMEBUFFER_PROFILING
+#error "The benchmark must be built with FRAMEBUFFER_PROFILING"
+#endif
+
+#define DEFAULT_ITERATIONS 50
+
+static const char* PRIMITIVE_NAMES[FrameBuffer::PRIMITIVE_COUNT] = { "clear", "text", "image", "fill", "qr_code" };
+
+struct ScenarioResult
+{
+    uint64_t totalNanos;
+    uint64_t minNanos;
+    FrameBuffer::PrimitiveProfile primitives[FrameBuffer::PRIMITIVE_COUNT];
+};
+
+static uint64_t nanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static ScenarioResult run(const Scenario &scenario, int iterations)
+{
+    ScenarioResult result = {
+        .totalNanos = 0,
+        .minNanos = UINT64_MAX,
+    };
+
+    scenario.setup();
+    scenario.render();
+    FrameBuffer::resetProfile();
+
+    for (int i = 0; i < iterations; ++i) {
+        const uint64_t start = nanos();
+        scenario.render();
+        const uint64_t elapsed = nanos() - start;
+        result.totalNanos += elapsed;
+        result.minNanos = min(result.minNanos, elapsed);
+    }
+
+    memcpy(result.primitives, FrameBuffer::profile, sizeof(result.primitives));
+    return result;
+}
+
+static void printResult(FILE *out, const Scenario &scenario, const ScenarioResult &result, int iterations, bool last)
+{
+    uint64_t primitiveNanos = 0;
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"name\": \"%s\",\n", scenario.name.c_str());
+    fprintf(out, "      \"ns_per_frame\": %llu,\n", (unsigned long long)(result.totalNanos / iterations));
+    fprintf(out, "      \"min_ns\": %llu,\n", (unsigned long long)result.minNanos);
+    fprintf(out, "      \"primitives\": {\n");
+    for (int p = 0; p < FrameBuffer::PRIMITIVE_COUNT; ++p) {
+        const FrameBuffer::PrimitiveProfile &profile = result.primitives[p];
+        primitiveNanos += profile.nanos;
+        fprintf(out, "        \"%s\": { \"calls_per_frame\": %.1f, \"ns_per_frame\": %llu }%s\n",
+            PRIMITIVE_NAMES[p],
+            (double)profile.calls / iterations,
+            (unsigned long long)(profile.nanos / iterations),
+            p + 1 < FrameBuffer::PRIMITIVE_COUNT ? "," : ""
+        );
+    }
+    fprintf(out, "      },\n");
+    // Reading settings, tile hashing and the simulated refresh
+    fprintf(out, "      \"other_ns_per_frame\": %llu\n",
+        (unsigned long long)((result.totalNanos > primitiveNanos ? result.totalNanos - primitiveNanos : 0) / iterations)
+    );
+    fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --iterations <n>     Timed renders per scenario (default %d)\n"
+        "  --filter <text>      Only run scenarios whose name contains text\n"
+        "  --output <file>      Write JSON to a file instead of stdout\n"
+        "  --list               List scenario names and exit\n",
+        name,
+        DEFAULT_ITERATIONS
+    );
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = DEFAULT_ITERATIONS;
+    const char *filter = nullptr;
+    const char *output = nullptr;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!strcmp(arg, "--list")) {
+            list = true;
+        } else if (!strcmp(arg, "--iterations") && value && (iterations = atoi(value)) > 0) {
+            ++i;
+        } else if (!strcmp(arg, "--filter") && value) {
+            filter = value;
+            ++i;
+        } else if (!strcmp(arg, "--output") && value) {
+            output = value;
+            ++i;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Config.begin();
+    setTimezone("UTC0");
+
+    std::vector<Scenario> scenarios;
+    for (const Scenario &scenario : buildScenarios()) {
+        if (!filter || scenario.name.find(filter) != std::string::npos) {
+            scenarios.push_back(scenario);
+        }
+    }
+
+    if (list) {
+        for (const Scenario &scenario : scenarios) {
+            printf("%s\n", scenario.name.c_str());
+        }
+        return 0;
+    }
+
+    FILE *out = output ? fopen(output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Cannot open %s for writing\n", output);
+        return 1;
+    }
+
+    uint64_t totalNanos = 0;
+    fprintf(out, "{\n");
+    fprintf(out, "  \"iterations\": %d,\n", iterations);
+    fprintf(out, "  \"scenarios\": [\n");
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        ScenarioResult result = run(scenarios[i], iterations);
+        totalNanos += result.totalNanos / iterations;
+        printResult(out, scenarios[i], result, iterations, i + 1 == scenarios.size());
+    }
+    fprintf(out, "  ],\n");
+    fprintf(out, "  \"total_ns\": %llu\n", (unsigned long long)totalNanos);
+    fprintf(out, "}\n");
+
+    return out == stdout || fclose(out) == 0 ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/**
+ * Golden image tests. Every scenario is rendered from a cleared display, or over the frame it says to draw first,
+ * and what ends up on the panel is compared against the reference PNG checked in under native/golden. The kind of
+ * refresh the display ended up doing is checked against the one the scenario expects.
+ *
+ * When a frame doesn't match, the actual frame is saved to the output directory along with a diff against the
+ * reference. In the diff, changed pixels are black and everything else is a faded copy of the reference.
+ *
+ * After an intended change to what gets drawn, run with --update to rewrite the references that changed.
+ */
+
+#include <errno.h>
+#include <sys/stat.h>
+#include "Display.h"
+#include "Configuration.h"
+#include "time_util.h"
+#include "NativePanel.h"
+#include "png_file.h"
+#include "scenarios.h"
+
+static bool makeDirectories(std::string path)
+{
+    for (size_t i = 1; i <= path.length(); ++i) {
+        if (i == path.length() || path[i] == '/') {
+            const std::string dir = path.substr(0, i);
+            if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool makeParentDirectories(const std::string &path)
+{
+    const size_t slash = path.rfind('/');
+    return slash == std::string::npos || slash == 0 || makeDirectories(path.substr(0, slash));
+}
+
+/**
+ * Writes a diff of the pixels against the reference image and returns how many pixels differ
+ */
+static size_t writeDiff(const std::string &path, const std::vector<uint8_t> &pixels, const std::vector<uint8_t> &reference)
+{
+    std::vector<uint8_t> diff(pixels.size());
+    size_t changed = 0;
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        if (pixels[i] != reference[i]) {
+            diff[i] = 0;
+            ++changed;
+        } else {
+            diff[i] = 192 + reference[i] / 4;
+        }
+    }
+    writePng(path, Panel.getWidth(), Panel.getHeight(), diff, 8);
+    return changed;
+}
+
+static const char* getRefreshTypeName(RefreshType type)
+{
+    switch (type) {
+        case RefreshType::FULL:
+            return "a full refresh";
+        case RefreshType::PARTIAL:
+            return "a partial refresh";
+        default:
+            return "no refresh";
+    }
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <reference dir> <output dir>\n"
+        "  --update             Rewrite the references that don't match the current frames\n"
+        "  --filter <text>      Only run scenarios whose name contains text\n",
+        name
+    );
+}
+
+int main(int argc, char **argv)
+{
+    bool update = false;
+    const char *filter = nullptr;
+    const char *referenceDir = nullptr;
+    const char *outputDir = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (!strcmp(arg, "--update")) {
+            update = true;
+        } else if (!strcmp(arg, "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg[0] != '-' && !referenceDir) {
+            referenceDir = arg;
+        } else if (arg[0] != '-' && !outputDir) {
+            outputDir = arg;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (!referenceDir || !outputDir) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Config.begin();
+    setTimezone("UTC0");
+
+    int failures = 0, passes = 0, updates = 0;
+
+    for (const Scenario &scenario : buildScenarios()) {
+        if (filter && scenario.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        scenario.setup();
+        // Start from a cleared display so the first refresh is a full one and the panel holds the whole frame
+        Display.fastClear();
+        if (scenario.previous) {
+            scenario.previous();
+        }
+        const uint32_t fullRefreshes = Panel.getFullRefreshCount();
+        const uint32_t partialRefreshes = Panel.getPartialRefreshCount();
+        scenario.render();
+        const RefreshType refresh = Panel.getFullRefreshCount() != fullRefreshes ? RefreshType::FULL
+            : Panel.getPartialRefreshCount() != partialRefreshes ? RefreshType::PARTIAL
+            : RefreshType::NONE;
+
+        if (refresh != scenario.refresh) {
+            ++failures;
+            printf("FAIL %s: expected %s, got %s\n",
+                scenario.name.c_str(),
+                getRefreshTypeName(scenario.refresh),
+                getRefreshTypeName(refresh)
+            );
+            continue;
+        }
+
+        const std::vector<uint8_t> pixels = Panel.getGreyscale();
+        const std::string referencePath = std::string(referenceDir) + "/" + scenario.name + ".png";
+        const std::vector<uint8_t> reference = readPng(referencePath, Panel.getWidth(), Panel.getHeight());
+        if (pixels == reference) {
+            ++passes;
+            continue;
+        }
+
+        if (update) {
+            // Only rewritten when the pixels changed, so an unrelated change doesn't touch every reference
+            if (!makeParentDirectories(referencePath) || !writePng(referencePath, Panel.getWidth(), Panel.getHeight(), pixels, 2)) {
+                fprintf(stderr, "Cannot write %s\n", referencePath.c_str());
+                return 1;
+            }
+            printf("Updated %s\n", referencePath.c_str());
+            ++updates;
+            continue;
+        }
+
+        ++failures;
+        std::string fileName = scenario.name;
+        std::replace(fileName.begin(), fileName.end(), '/', '-');
+        const std::string actualPath = std::string(outputDir) + "/" + fileName + ".actual.png";
+        if (!makeDirectories(outputDir) || !writePng(actualPath, Panel.getWidth(), Panel.getHeight(), pixels, 2)) {
+            fprintf(stderr, "Cannot write %s\n", actualPath.c_str());
+            return 1;
+        }
+        if (reference.empty()) {
+            printf("FAIL %s: no reference at %s, frame saved to %s\n", scenario.name.c_str(), referencePath.c_str(), actualPath.c_str());
+            continue;
+        }
+
+        const std::string diffPath = std::string(outputDir) + "/" + fileName + ".diff.png";
+        const size_t changed = writeDiff(diffPath, pixels, reference);
+        printf("FAIL %s: %zu pixels differ from %s, frame saved to %s, diff saved to %s\n",
+            scenario.name.c_str(),
+            changed,
+            referencePath.c_str(),
+            actualPath.c_str(),
+            diffPath.c_str()
+        );
+    }
+
+    if (update) {
+        printf("%d unchanged, %d updated, %d failed\n", passes, updates, failures);
+    } else {
+        printf("%d passed, %d failed\n", passes, failures);
+    }
+    return failures ? 1 : 0;
+}
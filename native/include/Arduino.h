@@ -0,0 +1,141 @@
+/**
+ * Minimal stand-in for the parts of the Arduino-ESP32 core that the rendering pipeline uses, so it can be
+ * built and run on a desktop machine. Only what the shared sources actually need is provided here.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <sys/time.h>
+
+#ifndef PORTALCALENDAR_NATIVE_ARDUINO_H
+#define PORTALCALENDAR_NATIVE_ARDUINO_H
+
+#ifndef CORE_DEBUG_LEVEL
+#define CORE_DEBUG_LEVEL 0
+#endif
+
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+
+#if CORE_DEBUG_LEVEL >= 1
+#define log_e(format, ...) fprintf(stderr, "[E][%s] " format "\n", __func__, ##__VA_ARGS__)
+#else
+#define log_e(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= 2
+#define log_w(format, ...) fprintf(stderr, "[W][%s] " format "\n", __func__, ##__VA_ARGS__)
+#else
+#define log_w(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= 3
+#define log_i(format, ...) fprintf(stderr, "[I][%s] " format "\n", __func__, ##__VA_ARGS__)
+#else
+#define log_i(...) do {} while (0)
+#endif
+#if CORE_DEBUG_LEVEL >= 4
+#define log_d(format, ...) fprintf(stderr, "[D][%s] " format "\n", __func__, ##__VA_ARGS__)
+#else
+#define log_d(...) do {} while (0)
+#endif
+
+#define LOW             0x0
+#define HIGH            0x1
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define INPUT_PULLUP    0x05
+#define INPUT_PULLDOWN  0x09
+#define HSPI            2
+#define VSPI            3
+
+typedef uint8_t byte;
+
+/**
+ * Unlike std::min/max these accept mixed argument types, the same as the Arduino macros they replace.
+ */
+template<typename A, typename B> inline typename std::common_type<A, B>::type min(A a, B b) { return b < a ? b : a; }
+template<typename A, typename B> inline typename std::common_type<A, B>::type max(A a, B b) { return a < b ? b : a; }
+
+inline unsigned long micros()
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void yield() {}
+
+inline void pinMode(uint8_t pin, uint8_t mode) {}
+inline void digitalWrite(uint8_t pin, uint8_t value) {}
+/**
+ * Every pin reads low, which among other things means the calendar always thinks it's running on battery.
+ */
+inline int digitalRead(uint8_t pin) { return LOW; }
+
+class String
+{
+public:
+    String() {}
+    String(const char *str) : _str(str ? str : "") {}
+    String(const std::string &str) : _str(str) {}
+    String(char c) : _str(1, c) {}
+    String(int value) : _str(std::to_string(value)) {}
+    String(unsigned int value) : _str(std::to_string(value)) {}
+    String(long value) : _str(std::to_string(value)) {}
+    String(unsigned long value) : _str(std::to_string(value)) {}
+
+    inline unsigned int length() const { return _str.length(); }
+    inline const char *c_str() const { return _str.c_str(); }
+    inline bool isEmpty() const { return _str.empty(); }
+    inline void reserve(unsigned int size) { _str.reserve(size); }
+    inline char charAt(unsigned int i) const { return (*this)[i]; }
+    inline char operator[](unsigned int i) const { return i < _str.length() ? _str[i] : '\0'; }
+
+    String substring(unsigned int start) const { return start < _str.length() ? String(_str.substr(start)) : String(); }
+    String substring(unsigned int start, unsigned int end) const
+    {
+        if (start > end) {
+            std::swap(start, end);
+        }
+        if (start >= _str.length()) {
+            return String();
+        }
+        return String(_str.substr(start, end - start));
+    }
+    int indexOf(char c, unsigned int from = 0) const { return find(_str.find(c, from)); }
+    int indexOf(const String &str, unsigned int from = 0) const { return find(_str.find(str._str, from)); }
+    inline bool startsWith(const String &str) const { return _str.compare(0, str._str.length(), str._str) == 0; }
+    inline bool equals(const String &str) const { return _str == str._str; }
+    inline bool operator==(const String &str) const { return _str == str._str; }
+    inline bool operator!=(const String &str) const { return _str != str._str; }
+
+    String& operator+=(const String &str) { _str += str._str; return *this; }
+    String& operator+=(const char *str) { _str += str; return *this; }
+    String& operator+=(char c) { _str += c; return *this; }
+    friend String operator+(const String &a, const String &b) { return String(a._str + b._str); }
+    friend String operator+(const String &a, const char *b) { return String(a._str + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b._str); }
+
+    inline std::string::const_iterator begin() const { return _str.begin(); }
+    inline std::string::const_iterator end() const { return _str.end(); }
+
+private:
+    std::string _str;
+
+    static inline int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+};
+
+#endif // PORTALCALENDAR_NATIVE_ARDUINO_H
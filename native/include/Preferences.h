@@ -0,0 +1,66 @@
+#include <Arduino.h>
+#include <map>
+
+#ifndef PORTALCALENDAR_NATIVE_PREFERENCES_H
+#define PORTALCALENDAR_NATIVE_PREFERENCES_H
+
+/**
+ * In-memory replacement for the ESP32 NVS-backed Preferences library. Every instance opened with the same
+ * namespace shares the same storage, so the simulator can set preferences that ConfigurationClass then reads.
+ */
+class Preferences
+{
+public:
+    bool begin(const char *name, bool readOnly = false)
+    {
+        _namespace = &storage()[name];
+        return true;
+    }
+    void end() { _namespace = nullptr; }
+    bool clear() { return _namespace && (_namespace->clear(), true); }
+    bool remove(const char *key) { return _namespace && _namespace->erase(key); }
+    bool isKey(const char *key) { return _namespace && _namespace->count(key); }
+
+    size_t putBool(const char *key, bool value) { return put(key, value ? "1" : "0"); }
+    size_t putUChar(const char *key, uint8_t value) { return put(key, std::to_string(value)); }
+    size_t putUInt(const char *key, uint32_t value) { return put(key, std::to_string(value)); }
+    size_t putFloat(const char *key, float value) { return put(key, std::to_string(value)); }
+    size_t putString(const char *key, const char *value) { return put(key, value); }
+    size_t putString(const char *key, const String &value) { return put(key, value.c_str()); }
+
+    bool getBool(const char *key, bool defaultValue = false) { auto v = get(key); return v ? std::stoi(*v) != 0 : defaultValue; }
+    uint8_t getUChar(const char *key, uint8_t defaultValue = 0) { auto v = get(key); return v ? (uint8_t)std::stoul(*v) : defaultValue; }
+    uint32_t getUInt(const char *key, uint32_t defaultValue = 0) { auto v = get(key); return v ? (uint32_t)std::stoul(*v) : defaultValue; }
+    float getFloat(const char *key, float defaultValue = NAN) { auto v = get(key); return v ? std::stof(*v) : defaultValue; }
+    String getString(const char *key, const String defaultValue = String()) { auto v = get(key); return v ? String(*v) : defaultValue; }
+
+private:
+    typedef std::map<std::string, std::string> Namespace;
+    Namespace *_namespace = nullptr;
+
+    static std::map<std::string, Namespace>& storage()
+    {
+        static std::map<std::string, Namespace> namespaces;
+        return namespaces;
+    }
+
+    size_t put(const char *key, const std::string &value)
+    {
+        if (!_namespace) {
+            return 0;
+        }
+        (*_namespace)[key] = value;
+        return value.length();
+    }
+
+    const std::string* get(const char *key)
+    {
+        if (!_namespace) {
+            return nullptr;
+        }
+        auto it = _namespace->find(key);
+        return it == _namespace->end() ? nullptr : &it->second;
+    }
+};
+
+#endif // PORTALCALENDAR_NATIVE_PREFERENCES_H
@@ -0,0 +1,15 @@
+#include <Arduino.h>
+
+#ifndef PORTALCALENDAR_NATIVE_SPI_H
+#define PORTALCALENDAR_NATIVE_SPI_H
+
+/**
+ * Only exists so DisplayGDEW075T7.h compiles, the native display driver never touches a bus.
+ */
+class SPIClass
+{
+public:
+    SPIClass(uint8_t spi_bus = HSPI) {}
+};
+
+#endif // PORTALCALENDAR_NATIVE_SPI_H
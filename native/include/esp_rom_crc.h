@@ -0,0 +1,34 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef PORTALCALENDAR_NATIVE_ESP_ROM_CRC_H
+#define PORTALCALENDAR_NATIVE_ESP_ROM_CRC_H
+
+/**
+ * Table driven CRC-32 (IEEE 802.3, reflected) with the same chaining semantics as the ESP32 ROM function,
+ * which is also table driven, so the cost of hashing frame buffer tiles is comparable in benchmarks.
+ */
+inline uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len)
+{
+    static const struct Table {
+        uint32_t entries[256];
+        Table()
+        {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int j = 0; j < 8; ++j) {
+                    c = (c >> 1) ^ (0xEDB88320 & (0 - (c & 1)));
+                }
+                entries[i] = c;
+            }
+        }
+    } table;
+
+    crc = ~crc;
+    while (len--) {
+        crc = table.entries[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+#endif // PORTALCALENDAR_NATIVE_ESP_ROM_CRC_H
@@ -0,0 +1,112 @@
+/**
+ * Renders a single screen through the real DisplayClass and writes what the panel ends up showing to a PGM file.
+ */
+
+#include "Display.h"
+#include "Configuration.h"
+#include "time_util.h"
+#include "NativePanel.h"
+#include "simulator.h"
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <output.pgm>\n"
+        "  --screen <calendar|error|welcome|config|diagnostics>\n"
+        "                                             Screen to render (default calendar)\n"
+        "  --date <YYYY-MM-DD>                        Date shown on the calendar (default 2023-04-18)\n"
+        "  --locale <code>                            Locale code (default " DEFAULT_LOCALE ")\n"
+        "  --weather <off|5day|12hour>                Show a sample forecast instead of chamber icons (default off)\n"
+        "  --units <imperial|metric>                  Weather units (default imperial)\n"
+        "  --info <pop|humidity>                      Secondary weather info (default pop)\n"
+        "  --24h                                      Use 24 hour time in the 12 hour forecast\n"
+        "  --tz <posix tz>                            Timezone (default UTC0)\n"
+        "  --message <text>                           Message for the error screen\n",
+        name
+    );
+}
+
+int main(int argc, char **argv)
+{
+    const char *screen = "calendar";
+    const char *tz = "UTC0";
+    const char *message = "NO WI-FI CONNECTION\n\nYour Wi-Fi network is either down, out of range, or you entered the wrong password.";
+    const char *output = nullptr;
+    int year = 2023, month = 4, mday = 18;
+    Preferences &prefs = simulatorPrefs();
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg[0] != '-') {
+            output = arg;
+            continue;
+        } else if (!strcmp(arg, "--24h")) {
+            prefs.putBool("show24Hr", true);
+            continue;
+        } else if (!value) {
+            usage(argv[0]);
+            return 1;
+        }
+        ++i;
+
+        if (!strcmp(arg, "--screen")) {
+            screen = value;
+        } else if (!strcmp(arg, "--date")) {
+            if (sscanf(value, "%d-%d-%d", &year, &month, &mday) != 3) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (!strcmp(arg, "--locale")) {
+            prefs.putString("locale", value);
+        } else if (!strcmp(arg, "--weather")) {
+            prefs.putBool("weatherEnabled", strcmp(value, "off") != 0);
+            prefs.putUChar("weatherDisplay", static_cast<uint8_t>(!strcmp(value, "12hour")
+                ? WeatherDisplayType::FORECAST_12_HOUR
+                : WeatherDisplayType::FORECAST_5_DAY
+            ));
+        } else if (!strcmp(arg, "--units")) {
+            prefs.putUChar("weatherUnits", static_cast<uint8_t>(!strcmp(value, "metric") ? WeatherUnits::METRIC : WeatherUnits::IMPERIAL));
+        } else if (!strcmp(arg, "--info")) {
+            prefs.putUChar("weatherInfo", static_cast<uint8_t>(!strcmp(value, "humidity") ? WeatherSecondaryInfo::HUMIDITY : WeatherSecondaryInfo::POP));
+        } else if (!strcmp(arg, "--tz")) {
+            tz = value;
+        } else if (!strcmp(arg, "--message")) {
+            message = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!output) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Config.begin();
+    setTimezone(tz);
+
+    if (!strcmp(screen, "calendar")) {
+        tm now = makeDate(year, month, mday);
+        now.tm_hour = 12;
+        loadSampleForecast(now);
+        Display.update(&now, getLocale(Config.getLocale()), Config.getWeatherEnabled());
+    } else if (!strcmp(screen, "error")) {
+        Display.error(message, true);
+    } else if (!strcmp(screen, "welcome")) {
+        Display.showWelcomeScreen();
+    } else if (!strcmp(screen, "config")) {
+        Display.showConfigServerScreen("PortalCalendar-1A2B", "12345678", DEFAULT_HOSTNAME, "");
+    } else if (!strcmp(screen, "diagnostics")) {
+        tm now = makeDate(year, month, mday);
+        const time_t t = mktime(&now);
+        loadSampleEnergyTotals(t);
+        Display.showDiagnosticsScreen(t);
+    } else {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return Panel.writePgm(output) ? 0 : 1;
+}
@@ -0,0 +1,307 @@
+"""
+Local stand-in for OpenWeatherMap, timezoned and NTP, so the calendar's network syncs can be tested and timed
+without the internet. Replays recorded responses with configurable latency and failures, and logs every request
+with how long it took to answer.
+
+Point the calendar at it by building the firmware with -DOWM_API_HOST='"<this machine>:8080"' and setting the NTP
+and timezoned servers in the config page to <this machine>:1123 and <this machine>:2342. NTP's usual port 123 needs
+root on Linux, so the NTP server listens on 1123 by default.
+
+    python3 native/mock_server.py --latency 200 --fail ntp=timeout:2
+"""
+
+import argparse
+import json
+import os.path as path
+import random
+import socket
+import socketserver
+import struct
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+NTP_EPOCH_OFFSET = 2208988800
+FORECAST_INTERVAL = 3 * 60 * 60
+
+# Recorded timezoned replies for a few zones, the rest get ERR like the real server gives for unknown names
+TIMEZONES = {
+    "America/Chicago": "CST6CDT,M3.2.0,M11.1.0",
+    "America/Los_Angeles": "PST8PDT,M3.2.0,M11.1.0",
+    "America/New_York": "EST5EDT,M3.2.0,M11.1.0",
+    "Asia/Tokyo": "JST-9",
+    "Australia/Sydney": "AEST-10AEDT,M10.1.0,M4.1.0/3",
+    "Europe/Berlin": "CET-1CEST,M3.5.0,M10.5.0/3",
+    "Europe/London": "GMT0BST,M3.5.0/1,M10.5.0",
+    "Europe/Zurich": "CET-1CEST,M3.5.0,M10.5.0/3",
+    "UTC": "UTC0",
+}
+GEOIP_TIMEZONE = "Europe/Zurich"
+
+CURRENT_WEATHER_RESPONSE = {
+    "coord": {"lon": 0, "lat": 51.48},
+    "weather": [{"id": 803, "main": "Clouds", "description": "broken clouds", "icon": "04d"}],
+    "main": {"temp": 284.2, "humidity": 71},
+    "cod": 200,
+}
+
+GEOCODING_RESPONSE = [
+    {"name": "Zürich", "lat": 47.3769, "lon": 8.5417, "country": "CH", "state": "Zurich"},
+]
+
+FAILURE_MODES = {
+    "http": ["timeout", "error", "unauthorized", "truncate", "malformed"],
+    "timezoned": ["timeout", "error"],
+    "ntp": ["timeout", "error"],
+}
+
+
+class Failures:
+    """
+    Decides which requests fail. Each service can be given a mode, which either applies to the first N requests so
+    retries can be seen succeeding, or to a random fraction of them.
+    """
+
+    def __init__(self, specs, seed):
+        self.modes = {}
+        self.counts = {}
+        self.random = random.Random(seed)
+        self.lock = threading.Lock()
+        for spec in specs:
+            service, _, rest = spec.partition("=")
+            mode, _, amount = rest.partition(":")
+            if service not in FAILURE_MODES or mode not in FAILURE_MODES[service]:
+                raise ValueError("Unknown failure '{}', see --help".format(spec))
+            self.modes[service] = (mode, amount)
+            self.counts[service] = 0
+
+    def check(self, service):
+        """
+        Returns the failure mode for the next request to a service, or None if it should succeed
+        """
+        if service not in self.modes:
+            return None
+        mode, amount = self.modes[service]
+        with self.lock:
+            self.counts[service] += 1
+            if not amount:
+                return mode
+            if "." in amount:
+                return mode if self.random.random() < float(amount) else None
+            return mode if self.counts[service] <= int(amount) else None
+
+
+class MockServer:
+    def __init__(self, args):
+        self.args = args
+        self.failures = Failures(args.fail, args.seed)
+        self.random = random.Random(args.seed)
+        self.lock = threading.Lock()
+        with open(args.forecast, "rb") as file:
+            self.forecast = json.load(file)
+
+    def log(self, service, started, message):
+        print("{:>9} {:6.0f}ms  {}".format(service, (time.monotonic() - started) * 1000, message), flush=True)
+
+    def wait(self, fraction=1.0):
+        """
+        Sleeps for the configured latency plus jitter, or a fraction of it
+        """
+        with self.lock:
+            jitter = self.random.uniform(-self.args.jitter, self.args.jitter)
+        time.sleep(max(0, self.args.latency + jitter) * fraction / 1000)
+
+    def forecast_body(self):
+        """
+        The recorded forecast, moved so it starts at the next 3 hour boundary unless --no-shift was given
+        """
+        if self.args.no_shift:
+            return json.dumps(self.forecast, separators=(",", ":")).encode()
+        forecast = json.loads(json.dumps(self.forecast))
+        first = forecast["list"][0]["dt"]
+        offset = (int(time.time()) // FORECAST_INTERVAL + 1) * FORECAST_INTERVAL - first
+        # Keep the sunrise and sunset at the same time of day
+        day_offset = offset - offset % (24 * 60 * 60)
+        for entry in forecast["list"]:
+            entry["dt"] += offset
+            entry["dt_txt"] = time.strftime("%Y-%m-%d %H:%M:%S", time.gmtime(entry["dt"]))
+        forecast["city"]["sunrise"] += day_offset
+        forecast["city"]["sunset"] += day_offset
+        return json.dumps(forecast, separators=(",", ":")).encode()
+
+
+def make_http_handler(server):
+    class Handler(BaseHTTPRequestHandler):
+        # The firmware requests HTTP/1.0 so the forecast isn't chunked
+        protocol_version = "HTTP/1.0"
+
+        def log_message(self, format, *args):
+            pass
+
+        def do_GET(self):
+            started = time.monotonic()
+            url = urlparse(self.path)
+            query = parse_qs(url.query)
+            server.wait()
+
+            failure = server.failures.check("http")
+            if failure == "timeout":
+                server.log("http", started, "{} -> no response".format(url.path))
+                time.sleep(server.args.timeout)
+                return
+            if failure == "error":
+                return self.reply(started, url.path, 500, b'{"cod":500,"message":"Internal error"}')
+            api_key = query.get("appid", [""])[0]
+            if failure == "unauthorized" or (server.args.api_key and api_key != server.args.api_key):
+                return self.reply(started, url.path, 401, b'{"cod":401,"message":"Invalid API key."}')
+
+            if url.path == "/data/2.5/forecast":
+                body = server.forecast_body()
+            elif url.path == "/data/2.5/weather":
+                body = json.dumps(CURRENT_WEATHER_RESPONSE).encode()
+            elif url.path == "/geo/1.0/direct":
+                body = json.dumps(GEOCODING_RESPONSE, ensure_ascii=False).encode()
+            else:
+                return self.reply(started, url.path, 404, b'{"cod":"404","message":"Not found"}')
+
+            if failure == "malformed":
+                body = body[:len(body) // 2] + b"}]" + body[len(body) // 2:]
+            self.reply(started, url.path, 200, body, truncate=failure == "truncate")
+
+        def reply(self, started, request_path, status, body, truncate=False):
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json; charset=utf-8")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            if truncate:
+                # Drop the connection halfway through, like a flaky network would
+                self.wfile.write(body[:len(body) // 2])
+                self.wfile.flush()
+                self.connection.shutdown(socket.SHUT_RDWR)
+                server.log("http", started, "{} -> {} truncated at {} of {} bytes".format(
+                    request_path, status, len(body) // 2, len(body)))
+                return
+            self.wfile.write(body)
+            server.log("http", started, "{} -> {}, {} bytes".format(request_path, status, len(body)))
+
+    return Handler
+
+
+def make_timezoned_handler(server):
+    class Handler(socketserver.BaseRequestHandler):
+        def handle(self):
+            started = time.monotonic()
+            data, sock = self.request
+            name = data.decode(errors="replace").strip()
+            server.wait()
+
+            failure = server.failures.check("timezoned")
+            if failure == "timeout":
+                server.log("timezoned", started, "{} -> no response".format(name))
+                return
+            if name == "GeoIP":
+                name = GEOIP_TIMEZONE
+            if failure == "error" or name not in TIMEZONES:
+                reply = "ERR Timezone Not Found"
+            else:
+                reply = "OK {} {}".format(name, TIMEZONES[name])
+            sock.sendto(reply.encode(), self.client_address)
+            server.log("timezoned", started, "{} -> {}".format(name, reply))
+
+    return Handler
+
+
+def ntp_timestamp(t):
+    seconds = int(t) + NTP_EPOCH_OFFSET
+    return struct.pack("!II", seconds & 0xFFFFFFFF, int((t % 1) * (1 << 32)) & 0xFFFFFFFF)
+
+
+def make_ntp_handler(server):
+    class Handler(socketserver.BaseRequestHandler):
+        def handle(self):
+            started = time.monotonic()
+            data, sock = self.request
+            if len(data) < 48:
+                return
+            # Half the latency on the way in and half on the way out, so the offset the client measures should be
+            # exactly --ntp-offset
+            server.wait(0.5)
+            received = time.time() + server.args.ntp_offset
+
+            failure = server.failures.check("ntp")
+            if failure == "timeout":
+                server.log("ntp", started, "no response")
+                return
+            # Stratum 0 is a kiss-o'-death packet, which the firmware rejects
+            stratum = 0 if failure == "error" else 2
+            reply = struct.pack("!BBbb", (4 << 3) | 4, stratum, 6, -20)
+            reply += struct.pack("!II", 0, 0)      # Root delay and dispersion
+            reply += b"MOCK"                        # Reference ID
+            reply += ntp_timestamp(received - 60)   # Reference timestamp
+            reply += data[40:48]                    # Origin timestamp, the client's transmit timestamp
+            reply += ntp_timestamp(received)        # Receive timestamp
+            reply += ntp_timestamp(received)        # Transmit timestamp
+            server.wait(0.5)
+            sock.sendto(reply, self.client_address)
+            server.log("ntp", started, "stratum {}, offset {:+.3f}s".format(stratum, server.args.ntp_offset))
+
+    return Handler
+
+
+class ThreadingUDPServer(socketserver.ThreadingMixIn, socketserver.UDPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Local stand-in for OpenWeatherMap, timezoned and NTP",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="Failures are given as service=mode[:amount], where amount is how many requests fail before they start "
+            "succeeding, or the fraction of requests that fail if it has a decimal point. Without an amount every "
+            "request fails.\n\n" + "\n".join(
+                "  {}: {}".format(service, ", ".join(modes)) for service, modes in FAILURE_MODES.items()
+            ),
+    )
+    parser.add_argument("--bind", default="0.0.0.0", help="Address to listen on (default 0.0.0.0)")
+    parser.add_argument("--http-port", type=int, default=8080, help="OpenWeatherMap port (default 8080)")
+    parser.add_argument("--timezoned-port", type=int, default=2342, help="Timezoned port (default 2342)")
+    parser.add_argument("--ntp-port", type=int, default=1123, help="NTP port (default 1123)")
+    parser.add_argument("--forecast", default=path.join(path.dirname(path.abspath(__file__)), "owm_forecast.json"),
+        help="Recorded forecast response (default native/owm_forecast.json)")
+    parser.add_argument("--no-shift", action="store_true",
+        help="Send the forecast as recorded instead of moving it to start now")
+    parser.add_argument("--api-key", help="Reply 401 to requests with any other OpenWeatherMap API key")
+    parser.add_argument("--latency", type=float, default=0, help="Milliseconds to wait before every reply")
+    parser.add_argument("--jitter", type=float, default=0, help="Random +/- milliseconds added to the latency")
+    parser.add_argument("--ntp-offset", type=float, default=0, help="Seconds to add to the time NTP replies with")
+    parser.add_argument("--fail", action="append", default=[], metavar="SERVICE=MODE[:AMOUNT]",
+        help="Make a service fail, can be given once per service")
+    parser.add_argument("--timeout", type=float, default=15,
+        help="Seconds an HTTP request that times out is held open (default 15)")
+    parser.add_argument("--seed", type=int, default=0, help="Seed for the jitter and random failures")
+    args = parser.parse_args()
+
+    try:
+        server = MockServer(args)
+    except ValueError as e:
+        parser.error(str(e))
+
+    http = ThreadingHTTPServer((args.bind, args.http_port), make_http_handler(server))
+    http.daemon_threads = True
+    timezoned = ThreadingUDPServer((args.bind, args.timezoned_port), make_timezoned_handler(server))
+    ntp = ThreadingUDPServer((args.bind, args.ntp_port), make_ntp_handler(server))
+    for service in (timezoned, ntp):
+        threading.Thread(target=service.serve_forever, daemon=True).start()
+
+    print("OpenWeatherMap on {}:{}, timezoned on {}:{}, NTP on {}:{}".format(
+        args.bind, args.http_port, args.bind, args.timezoned_port, args.bind, args.ntp_port), flush=True)
+    try:
+        http.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "png_file.h"
+
+static const uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+static void writeUint32(std::vector<uint8_t> &out, uint32_t value)
+{
+    out.push_back(value >> 24);
+    out.push_back(value >> 16);
+    out.push_back(value >> 8);
+    out.push_back(value);
+}
+
+static uint32_t readUint32(const uint8_t *data)
+{
+    return (uint32_t)data[0] << 24 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 8 | data[3];
+}
+
+static void writeChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+    writeUint32(out, data.size());
+    const size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    writeUint32(out, crc32(0, &out[start], out.size() - start));
+}
+
+static inline size_t getStride(uint32_t width, uint8_t bitDepth)
+{
+    return (width * bitDepth + 7) / 8;
+}
+
+bool writePng(const std::string &path, uint32_t width, uint32_t height, const std::vector<uint8_t> &pixels, uint8_t bitDepth)
+{
+    if ((bitDepth != 2 && bitDepth != 8) || pixels.size() != (size_t)width * height) {
+        return false;
+    }
+
+    // Every row uses filter type 0 (none), zlib does well enough on these without any
+    const size_t stride = getStride(width, bitDepth);
+    std::vector<uint8_t> raw((stride + 1) * height, 0);
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t *row = &raw[y * (stride + 1) + 1];
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint8_t grey = pixels[y * width + x];
+            if (bitDepth == 8) {
+                row[x] = grey;
+            } else {
+                row[x / 4] |= (grey / 85) << (6 - x % 4 * 2);
+            }
+        }
+    }
+
+    uLongf compressedLength = compressBound(raw.size());
+    std::vector<uint8_t> compressed(compressedLength);
+    if (compress2(compressed.data(), &compressedLength, raw.data(), raw.size(), Z_BEST_COMPRESSION) != Z_OK) {
+        return false;
+    }
+    compressed.resize(compressedLength);
+
+    std::vector<uint8_t> header;
+    writeUint32(header, width);
+    writeUint32(header, height);
+    header.push_back(bitDepth);
+    // Greyscale, deflate, adaptive filtering, no interlacing
+    header.insert(header.end(), { 0, 0, 0, 0 });
+
+    std::vector<uint8_t> png(PNG_SIGNATURE, PNG_SIGNATURE + sizeof(PNG_SIGNATURE));
+    writeChunk(png, "IHDR", header);
+    writeChunk(png, "IDAT", compressed);
+    writeChunk(png, "IEND", {});
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    const bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * Undoes the filter on a row in place. Greyscale pixels are at most a byte each, so the filters compare against
+ * the previous byte.
+ */
+static bool unfilterRow(uint8_t filter, uint8_t *row, const uint8_t *previous, size_t stride)
+{
+    for (size_t i = 0; i < stride; ++i) {
+        const int a = i ? row[i - 1] : 0;
+        const int b = previous ? previous[i] : 0;
+        const int c = i && previous ? previous[i - 1] : 0;
+        switch (filter) {
+            case 0:
+                break;
+            case 1:
+                row[i] += a;
+                break;
+            case 2:
+                row[i] += b;
+                break;
+            case 3:
+                row[i] += (a + b) / 2;
+                break;
+            case 4: {
+                const int p = a + b - c;
+                const int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+                row[i] += pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> readPng(const std::string &path, uint32_t width, uint32_t height)
+{
+    std::vector<uint8_t> pixels;
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return pixels;
+    }
+    std::vector<uint8_t> png;
+    uint8_t buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        png.insert(png.end(), buffer, buffer + length);
+    }
+    fclose(file);
+
+    if (png.size() < sizeof(PNG_SIGNATURE) || memcmp(png.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE))) {
+        return pixels;
+    }
+
+    uint8_t bitDepth = 0;
+    std::vector<uint8_t> compressed;
+    for (size_t offset = sizeof(PNG_SIGNATURE); offset + 12 <= png.size();) {
+        const uint32_t chunkLength = readUint32(&png[offset]);
+        if (chunkLength > png.size() - offset - 12) {
+            return pixels;
+        }
+        const char *type = (const char*)&png[offset + 4];
+        const uint8_t *data = &png[offset + 8];
+        if (!memcmp(type, "IHDR", 4)) {
+            // Only greyscale without interlacing
+            if (chunkLength != 13 || readUint32(data) != width || readUint32(data + 4) != height
+                || (data[8] != 2 && data[8] != 8) || data[9] != 0 || data[12] != 0) {
+                return pixels;
+            }
+            bitDepth = data[8];
+        } else if (!memcmp(type, "IDAT", 4)) {
+            compressed.insert(compressed.end(), data, data + chunkLength);
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        }
+        offset += chunkLength + 12;
+    }
+    if (!bitDepth) {
+        return pixels;
+    }
+
+    const size_t stride = getStride(width, bitDepth);
+    uLongf rawLength = (stride + 1) * height;
+    std::vector<uint8_t> raw(rawLength);
+    if (uncompress(raw.data(), &rawLength, compressed.data(), compressed.size()) != Z_OK || rawLength != raw.size()) {
+        return pixels;
+    }
+
+    std::vector<uint8_t> result(width * height);
+    const uint8_t *previous = nullptr;
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t *row = &raw[y * (stride + 1)];
+        if (!unfilterRow(row[0], row + 1, previous, stride)) {
+            return pixels;
+        }
+        previous = row + 1;
+        for (uint32_t x = 0; x < width; ++x) {
+            result[y * width + x] = bitDepth == 8 ? previous[x] : ((previous[x / 4] >> (6 - x % 4 * 2)) & 0b11) * 85;
+        }
+    }
+    pixels.swap(result);
+    return pixels;
+}
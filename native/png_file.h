@@ -0,0 +1,20 @@
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#ifndef PORTALCALENDAR_NATIVE_PNG_FILE_H
+#define PORTALCALENDAR_NATIVE_PNG_FILE_H
+
+/**
+ * Writes a greyscale PNG with the given bit depth (2 or 8). pixels holds one 8-bit grey level per pixel, which is
+ * scaled down to the bit depth.
+ */
+bool writePng(const std::string &path, uint32_t width, uint32_t height, const std::vector<uint8_t> &pixels, uint8_t bitDepth);
+
+/**
+ * Reads a non-interlaced greyscale PNG with a bit depth of 2 or 8, such as one written by writePng, and returns one
+ * 8-bit grey level per pixel. Returns an empty vector if the file can't be read or isn't the given size.
+ */
+std::vector<uint8_t> readPng(const std::string &path, uint32_t width, uint32_t height);
+
+#endif // PORTALCALENDAR_NATIVE_PNG_FILE_H
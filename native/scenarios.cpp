@@ -0,0 +1,263 @@
+#include "scenarios.h"
+#include "simulator.h"
+#include "NativePanel.h"
+#include "Display.h"
+#include "Configuration.h"
+#include "qrcodegen.h"
+#include "resources/font/medium.h"
+#include "resources/font/small.h"
+#include "resources/font/chamber_number.h"
+#include "resources/font/weather_frame.h"
+#include "resources/aperture_logo.h"
+#include "resources/wifi_48px.h"
+#include "resources/error.h"
+#include "resources/weather_frame.h"
+#include "resources/cube_dispenser_on.h"
+#include "resources/turret_hazard_off.h"
+
+using namespace qrcodegen;
+
+/**
+ * Scenario that draws the calendar for the given date, after clearing the settings and running setup
+ */
+static Scenario calendarScenario(std::string name, tm date, std::function<void(void)> setup = []() {})
+{
+    date.tm_hour = 12;
+    return {
+        .name = name,
+        .setup = [date, setup]() {
+            simulatorPrefs().clear();
+            setup();
+            Config.reload();
+            loadSampleForecast(date);
+        },
+        .render = [date]() {
+            Display.update(&date, getLocale(Config.getLocale()), Config.getWeatherEnabled());
+        },
+    };
+}
+
+/**
+ * Scenario that draws the calendar for the given date over what it drew for previousDate, with the sample forecast
+ * for forecastDate loaded for the first draw. Used to check which kind of refresh the redraw does.
+ */
+static Scenario redrawScenario(
+    std::string name,
+    tm previousDate,
+    tm forecastDate,
+    tm date,
+    RefreshType refresh,
+    std::function<void(void)> setup = []() {}
+) {
+    Scenario scenario = calendarScenario(name, date, setup);
+    previousDate.tm_hour = 12;
+    date.tm_hour = 12;
+    scenario.previous = [previousDate, forecastDate]() {
+        loadSampleForecast(forecastDate);
+        Display.update(&previousDate, getLocale(Config.getLocale()), Config.getWeatherEnabled());
+    };
+    scenario.render = [date]() {
+        loadSampleForecast(date);
+        Display.update(&date, getLocale(Config.getLocale()), Config.getWeatherEnabled());
+    };
+    scenario.refresh = refresh;
+    return scenario;
+}
+
+static Scenario screenScenario(std::string name, std::function<void(void)> render)
+{
+    return {
+        .name = name,
+        .setup = []() {
+            simulatorPrefs().clear();
+            Config.reload();
+        },
+        .render = render,
+    };
+}
+
+static std::function<void(void)> weatherSetup(WeatherDisplayType type)
+{
+    return [type]() {
+        simulatorPrefs().putBool("weatherEnabled", true);
+        simulatorPrefs().putUChar("weatherDisplay", static_cast<uint8_t>(type));
+    };
+}
+
+/**
+ * Scenario that draws the weather from native/owm_forecast.json, which starts on 2023-04-18
+ */
+static Scenario recordedWeatherScenario(std::string name, WeatherDisplayType type)
+{
+    tm date = makeDate(2023, 4, 18);
+    date.tm_hour = 12;
+    return {
+        .name = name,
+        .setup = [type]() {
+            simulatorPrefs().clear();
+            weatherSetup(type)();
+            Config.reload();
+            if (!loadRecordedForecast(OWM_FORECAST_RESPONSE)) {
+                fprintf(stderr, "Cannot load %s\n", OWM_FORECAST_RESPONSE);
+            }
+        },
+        .render = [date]() {
+            Display.update(&date, getLocale(Config.getLocale()), Config.getWeatherEnabled());
+        },
+    };
+}
+
+/**
+ * Exercises every FrameBuffer primitive, including clipping at each edge, negative sizes, every alignment,
+ * every alpha mode, greys, and text that wraps and uses non-ASCII glyphs.
+ */
+static void drawPrimitiveTestPattern(FrameBuffer &fb)
+{
+    fb.drawHLine(82, 50, 356, 2, FrameBuffer::BLACK, FrameBuffer::TOP_LEFT);
+    fb.drawHLine(82, 430, 356, 2, FrameBuffer::BLACK, FrameBuffer::TOP_LEFT);
+    fb.drawImage(IMG_APERTURE_LOGO, 82, 740);
+    fb.drawText("27", FONT_CHAMBER_NUMBER, 82, 16, FrameBuffer::TOP_LEFT, 10);
+    fb.drawText("27/31", FONT_MEDIUM, 82, 394);
+    fb.drawText("WEDNESDAY", FONT_MEDIUM, 438, 394, FrameBuffer::TOP_RIGHT);
+    for (int i = 0; i < 10; ++i) {
+        fb.drawImage(i % 2 ? IMG_CUBE_DISPENSER_ON : IMG_TURRET_HAZARD_OFF, 82 + (i % 5) * 73, 550 + (i / 5) * 73);
+    }
+
+    fb.drawImage(IMG_WEATHER_FRAME, 82, 550);
+    fb.setAlpha(FrameBuffer::BLACK);
+    fb.drawText("MON", FONT_WEATHER_FRAME, 87, 550);
+    fb.drawText("12", FONT_WEATHER_FRAME, 141, 550, FrameBuffer::TOP_RIGHT);
+    fb.setAlpha(FrameBuffer::NO_ALPHA);
+    fb.drawImage(IMG_WIFI_48PX, -20, -13);
+    fb.drawImage(IMG_ERROR, fb.getWidth() - 30, fb.getHeight() - 17);
+    fb.setAlpha(FrameBuffer::WHITE);
+    fb.drawImage(IMG_ERROR, 225, 300, FrameBuffer::BOTTOM_CENTER);
+    fb.drawMultilineText(
+        "NO WI-FI CONNECTION\n\nYour Wi-Fi network is either down, out of range, or you entered the wrong password. ÄÖÜ ß €",
+        FONT_SMALL,
+        225,
+        330,
+        408,
+        FrameBuffer::TOP_CENTER
+    );
+    fb.drawMultilineText("Will try again in 1 hour. Or, press the RESET button.", FONT_SMALL, 225, fb.getHeight() - 12, 400, FrameBuffer::BOTTOM_CENTER, 1, 2);
+
+    fb.strokeRect(10, 10, 101, 53, 3, FrameBuffer::DGREY, true, FrameBuffer::CENTER);
+    fb.strokeRect(300, 200, -41, 33, 1, FrameBuffer::LGREY);
+    fb.drawVLine(5, 700, -77, 3, FrameBuffer::BLACK);
+    fb.drawHLine(-5, 3, 1000, 7, FrameBuffer::DGREY, FrameBuffer::LEFT_CENTER);
+    fb.fillRect(-3, 795, 17, 13, FrameBuffer::LGREY);
+    fb.fillRect(477, -5, 9, 3007, FrameBuffer::DGREY);
+    fb.fillRect(101, 103, -7, -5, FrameBuffer::BLACK, FrameBuffer::BOTTOM_RIGHT);
+    for (int w = 0; w < 9; ++w) {
+        fb.fillRect(200 + w, 600 + w * 7, w, 5, (FrameBuffer::Color)(w & 3));
+    }
+
+    QrCode qrCode = QrCode::encodeText("WIFI:T:WPA;S:PortalCalendar;P:12345678;;", QrCode::Ecc::ECC_HIGH);
+    fb.drawQrCode(qrCode, 102, 95, 6);
+    fb.drawQrCode(qrCode, fb.getWidth() - 20, 700, 3);
+    fb.fillRect(220, 240, 66, 66, FrameBuffer::WHITE, FrameBuffer::CENTER);
+    fb.drawImage(IMG_WIFI_48PX, 220, 240, FrameBuffer::CENTER);
+}
+
+static Scenario primitivesScenario(FrameBuffer::Rotation rotation)
+{
+    return {
+        .name = "primitives/rotation-" + std::to_string(rotation * 90),
+        .setup = []() {},
+        .render = [rotation]() {
+            FrameBuffer frameBuffer(DisplayGDEW075T7::NATIVE_WIDTH, DisplayGDEW075T7::NATIVE_HEIGHT);
+            frameBuffer.setRotation(rotation);
+            frameBuffer.setAlpha(FrameBuffer::WHITE);
+            drawPrimitiveTestPattern(frameBuffer);
+            Panel.show(&frameBuffer, 0, 0, DisplayGDEW075T7::NATIVE_WIDTH, DisplayGDEW075T7::NATIVE_HEIGHT);
+        },
+    };
+}
+
+std::vector<Scenario> buildScenarios()
+{
+    std::vector<Scenario> scenarios;
+    char name[48];
+
+    // Every chamber icon set, January has all 31 days
+    for (int mday = 1; mday <= 31; ++mday) {
+        sprintf(name, "calendar/day-%02d", mday);
+        scenarios.push_back(calendarScenario(name, makeDate(2023, 1, mday)));
+    }
+    scenarios.push_back(calendarScenario("calendar/leap-day", makeDate(2024, 2, 29)));
+
+    scenarios.push_back(calendarScenario("weather/5-day", makeDate(2023, 4, 18), weatherSetup(WeatherDisplayType::FORECAST_5_DAY)));
+    scenarios.push_back(calendarScenario("weather/12-hour", makeDate(2023, 4, 18), weatherSetup(WeatherDisplayType::FORECAST_12_HOUR)));
+
+    // The same layouts from a recorded OWM response, to check ForecastParser
+    scenarios.push_back(recordedWeatherScenario("weather/owm-5-day", WeatherDisplayType::FORECAST_5_DAY));
+    scenarios.push_back(recordedWeatherScenario("weather/owm-12-hour", WeatherDisplayType::FORECAST_12_HOUR));
+
+    // Locales are drawn with the 5 day forecast since it's the only screen that uses the day abbreviations
+    for (const Locale &locale : LOCALES) {
+        const std::string code = locale.code;
+        scenarios.push_back(calendarScenario("locale/" + code, makeDate(2023, 9, 27), [code]() {
+            weatherSetup(WeatherDisplayType::FORECAST_5_DAY)();
+            simulatorPrefs().putString("locale", code.c_str());
+        }));
+    }
+
+    scenarios.push_back(screenScenario("screen/error", []() {
+        Display.error(
+            "NO WI-FI CONNECTION\n\nYour Wi-Fi network is either down, out of range, or you entered the wrong password.\n\n"
+            "Wi-Fi Name:\nPortal Calendar Test Network",
+            true
+        );
+    }));
+    // A word too long for the line followed by a newline, like a long Wi-Fi name without spaces
+    scenarios.push_back(screenScenario("screen/error-long-word", []() {
+        Display.error(
+            "NO WI-FI CONNECTION\n\nWi-Fi Name:\nPortalCalendarTestNetworkWithAVeryLongNameThatCannotBeWrapped\n\n"
+            "Check the name in the settings.",
+            true
+        );
+    }));
+    scenarios.push_back(screenScenario("screen/welcome", []() {
+        Display.showWelcomeScreen();
+    }));
+    scenarios.push_back(screenScenario("screen/config-server", []() {
+        Display.showConfigServerScreen("PortalCalendar-1A2B", "12345678", DEFAULT_HOSTNAME, "Home Wi-Fi");
+    }));
+    scenarios.push_back(screenScenario("screen/diagnostics", []() {
+        tm date = makeDate(2023, 4, 18);
+        const time_t now = mktime(&date);
+        loadSampleEnergyTotals(now);
+        Display.showDiagnosticsScreen(now);
+    }));
+
+    // Redraws over an earlier frame, the same as the firmware does when it wakes up
+    scenarios.push_back(redrawScenario(
+        "refresh/unchanged",
+        makeDate(2023, 4, 18),
+        makeDate(2023, 4, 18),
+        makeDate(2023, 4, 18),
+        RefreshType::NONE
+    ));
+    scenarios.push_back(redrawScenario(
+        "refresh/weather-update",
+        makeDate(2023, 4, 18),
+        makeDate(2023, 4, 17),
+        makeDate(2023, 4, 18),
+        RefreshType::PARTIAL,
+        weatherSetup(WeatherDisplayType::FORECAST_12_HOUR)
+    ));
+    scenarios.push_back(redrawScenario(
+        "refresh/next-day",
+        makeDate(2023, 4, 17),
+        makeDate(2023, 4, 17),
+        makeDate(2023, 4, 18),
+        RefreshType::FULL
+    ));
+
+    for (int rotation = FrameBuffer::ROTATION_0; rotation <= FrameBuffer::ROTATION_270; ++rotation) {
+        scenarios.push_back(primitivesScenario(static_cast<FrameBuffer::Rotation>(rotation)));
+    }
+
+    return scenarios;
+}
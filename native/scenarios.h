@@ -0,0 +1,40 @@
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifndef PORTALCALENDAR_NATIVE_SCENARIOS_H
+#define PORTALCALENDAR_NATIVE_SCENARIOS_H
+
+/**
+ * Which kind of display refresh render() is expected to end with
+ */
+enum class RefreshType
+{
+    FULL,
+    PARTIAL,
+    NONE,
+};
+
+/**
+ * Something the calendar can draw, used by both the benchmark and the golden image tests. setup() changes the
+ * settings and weather data the scenario needs, and render() draws it onto the simulated panel.
+ *
+ * The golden image tests clear the display before render(), so it does a full refresh. Scenarios that set previous
+ * have it drawn on the cleared display first instead, so render() only refreshes what changed since then.
+ */
+struct Scenario
+{
+    std::string name;
+    std::function<void(void)> setup;
+    std::function<void(void)> render;
+    std::function<void(void)> previous = nullptr;
+    RefreshType refresh = RefreshType::FULL;
+};
+
+/**
+ * Every chamber icon day, both weather layouts, every locale, the error, welcome and config server screens,
+ * a test pattern of FrameBuffer primitives in each rotation, and redraws that take each display refresh path.
+ */
+std::vector<Scenario> buildScenarios();
+
+#endif // PORTALCALENDAR_NATIVE_SCENARIOS_H
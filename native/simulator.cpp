@@ -0,0 +1,126 @@
+#include <vector>
+#include "simulator.h"
+#include "Configuration.h"
+#include "energy.h"
+#include "time_util.h"
+
+#define SAMPLE_FORECAST_ENTRIES 40
+#define SAMPLE_FORECAST_INTERVAL (3 * SECONDS_PER_HOUR)
+
+/**
+ * An OWM condition id for each WeatherCondition
+ */
+static const int SAMPLE_CONDITION_IDS[] = { 0, 800, 801, 802, 803, 804, 741, 500, 521, 211, 511, 600 };
+
+Preferences& simulatorPrefs()
+{
+    static Preferences prefs;
+    static bool opened = false;
+    if (!opened) {
+        opened = prefs.begin("portalcalendar");
+    }
+    return prefs;
+}
+
+tm makeDate(int year, int month, int mday)
+{
+    tm date = {};
+    date.tm_year = year - 1900;
+    date.tm_mon = month - 1;
+    date.tm_mday = mday;
+    date.tm_isdst = -1;
+    mktime(&date);
+    return date;
+}
+
+void loadSampleForecast(const tm &day)
+{
+    tm midnight = day;
+    midnight.tm_hour = midnight.tm_min = midnight.tm_sec = 0;
+    midnight.tm_isdst = -1;
+    const time_t start = mktime(&midnight);
+
+    // Written out as an OWM response, so it goes through the same parser and storage as a real forecast
+    std::string response = "{\"cod\":\"200\",\"cnt\":40,\"list\":[";
+    char entry[200];
+    for (int i = 0; i < SAMPLE_FORECAST_ENTRIES; ++i) {
+        const int condition = 1 + (i * 7) % static_cast<int>(WeatherCondition::SNOW);
+        snprintf(entry, sizeof(entry),
+            "%s{\"dt\":%lld,\"main\":{\"temp\":%d,\"humidity\":%d},\"weather\":[{\"id\":%d}],"
+            "\"clouds\":{\"all\":%d},\"pop\":%0.2f}",
+            i ? "," : "",
+            (long long)(start + i * SAMPLE_FORECAST_INTERVAL),
+            (int)round(12.0 + 9.0 * sin((i - 2) * M_PI / 4.0) + i / 8),
+            35 + (i * 11) % 60,
+            SAMPLE_CONDITION_IDS[condition],
+            (i * 23) % 101,
+            ((i * 37) % 101) / 100.0
+        );
+        response += entry;
+    }
+    snprintf(entry, sizeof(entry), "],\"city\":{\"sunrise\":%lld,\"sunset\":%lld}}",
+        (long long)(start + 6 * SECONDS_PER_HOUR + 30 * 60),
+        (long long)(start + 19 * SECONDS_PER_HOUR + 45 * 60)
+    );
+    response += entry;
+
+    ForecastParser parser;
+    parser.parse(response.data(), response.length());
+    parser.finish();
+    lastWeatherSync = start;
+}
+
+bool loadRecordedForecast(const char *path, size_t chunkSize)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    ForecastParser parser;
+    std::vector<char> buffer(chunkSize);
+    size_t length;
+    while ((length = fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        parser.parse(buffer.data(), length);
+    }
+    fclose(file);
+    if (!parser.finish()) {
+        return false;
+    }
+    time(&lastWeatherSync);
+    return true;
+}
+
+void loadSampleEnergyTotals(time_t now)
+{
+    resetEnergyTotals();
+    const int days = 30;
+    const time_t start = now - days * SECONDS_PER_DAY;
+    // Wakes only count once the clock has been synced
+    lastNtpSync = start;
+    for (int day = 0; day < days; ++day) {
+        // Two NTP syncs before midnight, then the display update at midnight
+        for (int wake = 0; wake < 3; ++wake) {
+            WakeProfile profile = {
+                .wakeTime = start + day * SECONDS_PER_DAY + wake * 3600,
+                .sleepSeconds = wake < 2 ? 3600u : (uint32_t)(SECONDS_PER_DAY - 2 * 3600),
+            };
+            profile.phaseMicros[static_cast<size_t>(WakePhase::BOOT)] = 250000;
+            profile.phaseMicros[static_cast<size_t>(WakePhase::CONFIG_LOAD)] = 20000 + day * 100;
+            profile.phaseMicros[static_cast<size_t>(WakePhase::WIFI)] = 1800000 + wake * 150000;
+            profile.phaseMicros[static_cast<size_t>(WakePhase::NTP_SYNC)] = 90000;
+            if (wake == 0) {
+                profile.phaseMicros[static_cast<size_t>(WakePhase::TZ_LOOKUP)] = 300000;
+                profile.phaseMicros[static_cast<size_t>(WakePhase::WEATHER_HTTP)] = 600000;
+                profile.phaseMicros[static_cast<size_t>(WakePhase::WEATHER_PARSE)] = 400000;
+            }
+            if (wake == 2) {
+                profile.phaseMicros[static_cast<size_t>(WakePhase::RENDER)] = 180000;
+                profile.phaseMicros[static_cast<size_t>(WakePhase::SPI_UPLOAD)] = 110000;
+                profile.phaseMicros[static_cast<size_t>(WakePhase::PANEL_REFRESH)] = 3900000;
+            }
+            profile.phaseMicros[static_cast<size_t>(WakePhase::SLEEP)] = 5000;
+            recordWakeEnergy(profile);
+            recordSleepEnergy(profile.sleepSeconds);
+        }
+    }
+}
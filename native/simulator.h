@@ -0,0 +1,36 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "weather.h"
+
+#ifndef PORTALCALENDAR_NATIVE_SIMULATOR_H
+#define PORTALCALENDAR_NATIVE_SIMULATOR_H
+
+/**
+ * Opens the same preferences namespace that ConfigurationClass uses, so settings can be changed before rendering.
+ * Call Config.reload() after changing them.
+ */
+Preferences& simulatorPrefs();
+
+/**
+ * Returns midnight on the given date (month is 1-12) in the current timezone, with tm_wday/tm_yday filled in
+ */
+tm makeDate(int year, int month, int mday);
+
+/**
+ * Fills the weather cache with a made up but deterministic 5-day/3-hour forecast starting at midnight on
+ * the given day. Conditions cycle through every WeatherCondition so all the weather icons get drawn.
+ */
+void loadSampleForecast(const tm &day);
+
+/**
+ * Fills the weather cache by running a recorded OWM forecast response through ForecastParser, fed in chunks the same
+ * size the firmware reads from the socket. Returns false if the file can't be read or doesn't parse.
+ */
+bool loadRecordedForecast(const char *path, size_t chunkSize = 256);
+
+/**
+ * Replaces the battery usage totals with a made up but deterministic month of wakes and sleeps ending at the given time
+ */
+void loadSampleEnergyTotals(time_t now);
+
+#endif // PORTALCALENDAR_NATIVE_SIMULATOR_H
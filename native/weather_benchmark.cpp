@@ -0,0 +1,305 @@
+/**
+ * Times ForecastParser on a 40 entry response from OWM's 5-day/3-hour forecast API and prints the results as JSON,
+ * so runs from different commits can be diffed.
+ *
+ * The response is fed to the parser from memory in chunks the same size the firmware reads from the socket, so the
+ * times only include parsing. The memory numbers are what the parse needs on top of the weather cache itself: the
+ * parser and read buffer on the stack, and any heap allocations, which are counted by replacing operator new.
+ *
+ * When ArduinoJson is found at build time, the filtered deserializeJson that ForecastParser replaced is timed the same
+ * way, with its allocations counted through a custom allocator. It's given the whole response at once, which flatters
+ * it a little since the firmware used to read the socket through a Stream.
+ */
+
+#ifdef ARDUINOJSON_BASELINE
+#include <ArduinoJson.h>
+#endif
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "Configuration.h"
+#include "time_util.h"
+#include "weather.h"
+
+#define DEFAULT_ITERATIONS 1000
+#define DEFAULT_CHUNK_SIZE 256
+
+/**
+ * Heap usage, counted for every allocation made through operator new or the ArduinoJson allocator
+ */
+struct HeapStats
+{
+    size_t allocations;
+    size_t bytes;
+    size_t current;
+    size_t peak;
+};
+
+static HeapStats heap = {};
+
+/**
+ * Allocations are prefixed with their size so frees can be counted too
+ */
+static const size_t HEAP_HEADER_SIZE = alignof(std::max_align_t);
+
+static void* countedMalloc(size_t size)
+{
+    uint8_t *p = static_cast<uint8_t*>(malloc(size + HEAP_HEADER_SIZE));
+    if (!p) {
+        return nullptr;
+    }
+    *reinterpret_cast<size_t*>(p) = size;
+    ++heap.allocations;
+    heap.bytes += size;
+    heap.current += size;
+    heap.peak = max(heap.peak, heap.current);
+    return p + HEAP_HEADER_SIZE;
+}
+
+static void countedFree(void *p)
+{
+    if (p) {
+        uint8_t *block = static_cast<uint8_t*>(p) - HEAP_HEADER_SIZE;
+        heap.current -= *reinterpret_cast<size_t*>(block);
+        free(block);
+    }
+}
+
+void* operator new(size_t size)
+{
+    void *p = countedMalloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    countedFree(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    countedFree(p);
+}
+
+static uint64_t nanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool readFile(const char *path, std::vector<char> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char buffer[4096];
+    size_t length;
+    while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + length);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * Parses the response once, and returns the number of forecast entries or -1 if it didn't parse
+ */
+typedef std::function<int(const std::vector<char> &response, size_t chunkSize)> ParseFunction;
+
+static int parseWithForecastParser(const std::vector<char> &response, size_t chunkSize)
+{
+    ForecastParser parser;
+    for (size_t offset = 0; offset < response.size(); offset += chunkSize) {
+        parser.parse(&response[offset], min(chunkSize, response.size() - offset));
+    }
+    return parser.finish() ? parser.getEntryCount() : -1;
+}
+
+#ifdef ARDUINOJSON_BASELINE
+class CountingAllocator : public ArduinoJson::Allocator
+{
+public:
+    void* allocate(size_t size) override
+    {
+        return countedMalloc(size);
+    }
+
+    void deallocate(void *p) override
+    {
+        countedFree(p);
+    }
+
+    void* reallocate(void *p, size_t size) override
+    {
+        void *resized = countedMalloc(size);
+        if (resized && p) {
+            const size_t oldSize = *reinterpret_cast<size_t*>(static_cast<uint8_t*>(p) - HEAP_HEADER_SIZE);
+            memcpy(resized, p, min(oldSize, size));
+            countedFree(p);
+        }
+        return resized;
+    }
+};
+
+static CountingAllocator countingAllocator;
+
+/**
+ * What refreshWeather did before ForecastParser: deserialize the fields it needs into a JsonDocument, then read every
+ * entry out of it into the weather cache
+ */
+static int parseWithArduinoJson(const std::vector<char> &response, size_t)
+{
+    JsonDocument filter(&countingAllocator);
+    filter["city"]["sunrise"] = true;
+    filter["city"]["sunset"] = true;
+    filter["cnt"] = true;
+    filter["list"][0]["dt"] = true;
+    filter["list"][0]["main"]["temp"] = true;
+    filter["list"][0]["main"]["humidity"] = true;
+    filter["list"][0]["clouds"]["all"] = true;
+    filter["list"][0]["weather"][0]["id"] = true;
+    filter["list"][0]["pop"] = true;
+
+    JsonDocument document(&countingAllocator);
+    if (deserializeJson(document, response.data(), response.size(), DeserializationOption::Filter(filter))) {
+        return -1;
+    }
+
+    static volatile int64_t sink;
+    JsonVariant city = document["city"];
+    sink = city["sunrise"].as<int64_t>() + city["sunset"].as<int64_t>();
+    const int count = min(document["cnt"].as<int>(), WEATHER_ENTRY_COUNT);
+    JsonArray list = document["list"];
+    for (int i = 0; i < count; ++i) {
+        JsonVariant entry = list[i];
+        sink = entry["dt"].as<int64_t>()
+            + (int)round(entry["main"]["temp"].as<float>())
+            + entry["main"]["humidity"].as<int>()
+            + entry["clouds"]["all"].as<int>()
+            + entry["weather"][0]["id"].as<int>()
+            + (int)round(entry["pop"].as<float>() * 100.0);
+    }
+    return count;
+}
+#endif // ARDUINOJSON_BASELINE
+
+/**
+ * Times a parser and prints its results as a JSON object
+ */
+static bool benchmark(
+    const char *name,
+    ParseFunction parse,
+    size_t stackBytes,
+    const std::vector<char> &response,
+    int iterations,
+    size_t chunkSize,
+    bool last
+) {
+    uint64_t totalNanos = 0, minNanos = UINT64_MAX;
+    int entries = 0;
+    const HeapStats before = heap;
+    heap.peak = heap.current;
+    for (int i = 0; i < iterations; ++i) {
+        const uint64_t start = nanos();
+        entries = parse(response, chunkSize);
+        const uint64_t elapsed = nanos() - start;
+        if (entries < 0) {
+            fprintf(stderr, "%s failed to parse the response\n", name);
+            return false;
+        }
+        totalNanos += elapsed;
+        minNanos = min(minNanos, elapsed);
+    }
+
+    printf("    {\n");
+    printf("      \"name\": \"%s\",\n", name);
+    printf("      \"entries\": %d,\n", entries);
+    printf("      \"ns_per_parse\": %llu,\n", (unsigned long long)(totalNanos / iterations));
+    printf("      \"min_ns\": %llu,\n", (unsigned long long)minNanos);
+    printf("      \"stack_bytes\": %zu,\n", stackBytes);
+    printf("      \"heap_allocations_per_parse\": %.1f,\n", (double)(heap.allocations - before.allocations) / iterations);
+    printf("      \"heap_bytes_per_parse\": %.1f,\n", (double)(heap.bytes - before.bytes) / iterations);
+    printf("      \"peak_heap_bytes\": %zu\n", heap.peak - before.current);
+    printf("    }%s\n", last ? "" : ",");
+    return true;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --iterations <n>     Timed parses (default %d)\n"
+        "  --chunk <bytes>      Bytes passed to the parser at a time (default %d)\n"
+        "  --response <file>    Forecast response to parse (default %s)\n",
+        name,
+        DEFAULT_ITERATIONS,
+        DEFAULT_CHUNK_SIZE,
+        OWM_FORECAST_RESPONSE
+    );
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = DEFAULT_ITERATIONS;
+    int chunkSize = DEFAULT_CHUNK_SIZE;
+    const char *path = OWM_FORECAST_RESPONSE;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!strcmp(arg, "--iterations") && value && (iterations = atoi(value)) > 0) {
+            ++i;
+        } else if (!strcmp(arg, "--chunk") && value && (chunkSize = atoi(value)) > 0) {
+            ++i;
+        } else if (!strcmp(arg, "--response") && value) {
+            path = value;
+            ++i;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    Config.begin();
+    setTimezone("UTC0");
+
+    std::vector<char> response;
+    if (!readFile(path, response)) {
+        fprintf(stderr, "Cannot read %s\n", path);
+        return 1;
+    }
+
+    #ifdef ARDUINOJSON_BASELINE
+    const bool haveBaseline = true;
+    #else
+    const bool haveBaseline = false;
+    #endif
+
+    printf("{\n");
+    printf("  \"iterations\": %d,\n", iterations);
+    printf("  \"response_bytes\": %zu,\n", response.size());
+    printf("  \"chunk_bytes\": %d,\n", chunkSize);
+    printf("  \"parsers\": [\n");
+    if (!benchmark(
+        "ForecastParser",
+        parseWithForecastParser,
+        sizeof(ForecastParser) + chunkSize,
+        response,
+        iterations,
+        chunkSize,
+        !haveBaseline
+    )) {
+        return 1;
+    }
+    #ifdef ARDUINOJSON_BASELINE
+    if (!benchmark("ArduinoJson", parseWithArduinoJson, 2 * sizeof(JsonDocument), response, iterations, chunkSize, true)) {
+        return 1;
+    }
+    #endif
+    printf("  ]\n");
+    printf("}\n");
+    return 0;
+}
@@ -7,6 +7,9 @@
 #include "Display.h"
 #include "driver/rtc_io.h"
 #include "weather.h"
+#include "profiler.h"
+#include "energy.h"
+#include "BackgroundTask.h"
 
 const uint8_t ACTION_NTP_SYNC = 0b001;
 const uint8_t ACTION_TZ_SYNC = 0b010;
@@ -33,8 +36,20 @@ RTC_DATA_ATTR int displayedYDay = 0;
 RTC_DATA_ATTR bool showWeather = false;
 RTC_DATA_ATTR time_t displayedWeatherTime = 0;
 
+/**
+ * Finishes profiling this wake and adds it to the battery usage estimate, unless the batteries aren't being used
+ */
+void endWake(uint32_t sleepSeconds)
+{
+    const WakeProfile *profile = profilerEnd(sleepSeconds);
+    if (profile && !Config.isOnUsbPower()) {
+        recordWakeEnergy(*profile);
+    }
+}
+
 void deepSleep(time_t seconds)
 {
+    ProfilePhase phase(WakePhase::SLEEP);
     time(&sleepStartTime);
     scheduledWakeup = sleepStartTime + seconds;
     correctSleepDuration(&seconds);
@@ -52,12 +67,14 @@ void deepSleep(time_t seconds)
 
     // Enable timer wakeup
     esp_sleep_enable_timer_wakeup((uint64_t)seconds * uS_PER_S);
+    endWake(seconds);
     esp_deep_sleep_start();
 }
 
 void stopWifi()
 {
     if (WiFi.getMode() != WIFI_OFF) {
+        ProfilePhase phase(WakePhase::WIFI);
         log_i("Stopping Wi-Fi");
         unsigned long start = millis();
         WiFi.disconnect(true, true);
@@ -157,6 +174,7 @@ void errorBrownout()
     );
     // Sleep forever
     esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+    endWake(0);
     esp_deep_sleep_start();
 }
 
@@ -178,71 +196,140 @@ void showWelcomeScreen()
     Display.showWelcomeScreen();
     // Sleep forever
     esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+    endWake(0);
     esp_deep_sleep_start();
 }
 
+/**
+ * Runs every sync that's due over one Wi-Fi connection, then shuts Wi-Fi down. The syncs run at the same time on their
+ * own tasks, so the whole session takes about as long as the slowest one rather than all of them added up. Syncs give
+ * up after NETWORK_SESSION_TIMEOUT_MS and stay scheduled for the next wake, unless the calendar can't work without them.
+ */
 void runScheduledActions()
 {
-    // Sync timezone
+    if (!Config.getWeatherEnabled()) {
+        // Weather not enabled, do nothing and clear the action
+        scheduledActions &= ~ACTION_WEATHER_SYNC;
+    }
 
-    if ((scheduledActions & ACTION_TZ_SYNC) || !isSystemTimeValid()) {
-        if (Config.connectToSavedWifi()) {
+    const bool tzSyncDue = (scheduledActions & ACTION_TZ_SYNC) || !isSystemTimeValid();
+    const bool ntpSyncDue = (scheduledActions & ACTION_NTP_SYNC) || !lastNtpSync;
+    const bool weatherSyncDue = Config.getWeatherEnabled() && ((scheduledActions & ACTION_WEATHER_SYNC) || !lastWeatherSync);
+
+    if (!tzSyncDue && !ntpSyncDue && !weatherSyncDue) {
+        return;
+    }
+
+    if (!Config.connectToSavedWifi()) {
+        if ((tzSyncDue && !savedTimezone[0])            // No idea what timezone we're in
+            || (ntpSyncDue && !isSystemTimeValid())     // No idea what time it is
+            || (weatherSyncDue && !lastWeatherSync)
+        ) {
+            errorNoWifi();
+        }
+        stopWifi();
+        return;
+    }
+
+    const String primaryTimezonedServer = Config.getPrimaryTimezonedServer();
+    const String secondaryTimezonedServer = Config.getSecondaryTimezonedServer();
+    const String timezoneName = Config.getTimezoneName();
+    const String primaryNtpServer = Config.getPrimaryNtpServer();
+    const String secondaryNtpServer = Config.getSecondaryNtpServer();
+
+    // Syncs the calendar can't show anything without are only limited by their own timeouts
+    const uint32_t tzTimeout = savedTimezone[0] ? NETWORK_SESSION_TIMEOUT_MS : UINT32_MAX;
+    const uint32_t ntpTimeout = isSystemTimeValid() ? NETWORK_SESSION_TIMEOUT_MS : UINT32_MAX;
+    const uint32_t weatherTimeout = lastWeatherSync ? NETWORK_SESSION_TIMEOUT_MS : UINT32_MAX;
+
+    TimezonedResult tzResult = TimezonedResult::ServerError;
+    bool ntpSynced = false;
+    OwmResult weatherResult = OwmResult::NO_RESPONSE;
+    {
+        ProfilePhase phase(WakePhase::NETWORK_SYNC);
+        const unsigned long start = millis();
+
+        BackgroundTask *tzTask = !tzSyncDue ? nullptr : new BackgroundTask("tzLookup", [&]() {
             String tz;
-            TimezonedResult result = getPosixTz(
-                { Config.getPrimaryTimezonedServer(), Config.getSecondaryTimezonedServer() },
-                Config.getTimezoneName(),
-                tz
-            );
-            if (result == TimezonedResult::Ok) {
+            tzResult = getPosixTz({ primaryTimezonedServer, secondaryTimezonedServer }, timezoneName, tz, tzTimeout);
+            if (tzResult == TimezonedResult::Ok) {
                 setTimezone(tz.c_str());
-                scheduledActions &= ~ACTION_TZ_SYNC;
-            } else if (!savedTimezone[0]) {
-                errorTzLookupFailed();
             }
+        });
+        BackgroundTask *ntpTask = !ntpSyncDue ? nullptr : new BackgroundTask("ntpSync", [&]() {
+            ntpSynced = syncNtp({ primaryNtpServer, secondaryNtpServer }, false, ntpTimeout);
+        });
+        BackgroundTask *weatherTask = !weatherSyncDue ? nullptr : new BackgroundTask("weather", [&]() {
+            // The sync is stamped with the system time, and the day index built after parsing uses the timezone,
+            // so wait for both before parsing
+            weatherResult = refreshWeather([&]() {
+                if (tzTask) {
+                    tzTask->join();
+                }
+                if (ntpTask) {
+                    ntpTask->join();
+                }
+            }, weatherTimeout);
+        });
+
+        if (tzTask) {
+            tzTask->join();
+            profilerRecordSync(WakeSync::TZ_LOOKUP, tzTask->getMicros());
+        }
+        if (ntpTask) {
+            ntpTask->join();
+            profilerRecordSync(WakeSync::NTP_SYNC, ntpTask->getMicros());
+        }
+        if (weatherTask) {
+            weatherTask->join();
+            profilerRecordSync(WakeSync::WEATHER, weatherTask->getMicros());
+        }
+        log_i(
+            "Syncs took %lums together (timezone %ums, NTP %ums, weather %ums)",
+            millis() - start,
+            tzTask ? tzTask->getMicros() / 1000 : 0,
+            ntpTask ? ntpTask->getMicros() / 1000 : 0,
+            weatherTask ? weatherTask->getMicros() / 1000 : 0
+        );
+        delete tzTask;
+        delete ntpTask;
+        delete weatherTask;
+    }
+    stopWifi();
+
+    // Timezone
+
+    if (tzSyncDue) {
+        if (tzResult == TimezonedResult::Ok) {
+            scheduledActions &= ~ACTION_TZ_SYNC;
         } else if (!savedTimezone[0]) {
-            // WiFi didn't connect and we have no idea what timezone we're in
-            errorNoWifi();
+            errorTzLookupFailed();
         }
     }
 
-    // Sync time
+    // Time
 
-    if ((scheduledActions & ACTION_NTP_SYNC) || !lastNtpSync) {
-        if (Config.connectToSavedWifi()) {
-            if (syncNtp({ Config.getPrimaryNtpServer(), Config.getSecondaryNtpServer() })) {
-                scheduledActions &= ~ACTION_NTP_SYNC;
-            } else if (!isSystemTimeValid()) {
-                // Sync unsuccesful and we have no idea what time it is
-                errorNtpFailed();
-            }
+    if (ntpSyncDue) {
+        if (ntpSynced) {
+            scheduledActions &= ~ACTION_NTP_SYNC;
         } else if (!isSystemTimeValid()) {
-            // WiFi didn't connect and we have no idea what time it is
-            errorNoWifi();
+            // Sync unsuccesful and we have no idea what time it is
+            errorNtpFailed();
         }
     }
 
-    // Sync weather
-    
-    if ((scheduledActions & ACTION_WEATHER_SYNC) || !lastWeatherSync) {
-        if (Config.getWeatherEnabled()) {
-            if (Config.connectToSavedWifi()) {
-                OwmResult result = refreshWeather();
-                switch (result) {
-                    case OwmResult::SUCCESS:
-                        scheduledActions &= ~ACTION_WEATHER_SYNC;
-                        break;
-                    case OwmResult::INVALID_API_KEY:
-                        errorInvalidOwmApiKey();
-                    default:
-                        // Ignore other OWM errors because weather isn't critical
-                        break;
-                }
-            } else if (!lastWeatherSync) {
-                errorNoWifi();
-            }
-        } else {
-            // Weather not enabled, do nothing and clear the action
-            scheduledActions &= ~ACTION_WEATHER_SYNC;
+    // Weather
+
+    if (weatherSyncDue) {
+        switch (weatherResult) {
+            case OwmResult::SUCCESS:
+                scheduledActions &= ~ACTION_WEATHER_SYNC;
+                break;
+            case OwmResult::INVALID_API_KEY:
+                errorInvalidOwmApiKey();
+            default:
+                // Ignore other OWM errors because weather isn't critical
+                break;
         }
     }
 }
@@ -257,9 +344,13 @@ void setup()
     #endif
 
     setTimezone();
+    uint32_t sleptSeconds = 0;
     if (sleepStartTime) {
         correctSystemClock(t - sleepStartTime);
         time(&t);
+        if (t > sleepStartTime) {
+            sleptSeconds = t - sleepStartTime;
+        }
         sleepStartTime = 0;
     }
 
@@ -267,6 +358,7 @@ void setup()
 
     const esp_reset_reason_t resetReason = esp_reset_reason();
     const esp_sleep_wakeup_cause_t wakeupCause = esp_sleep_get_wakeup_cause();
+    profilerBegin(t, wakeupCause);
 
     log_i("Wakeup cause: %u, Reset reason: %u", wakeupCause, resetReason);
 
@@ -282,7 +374,15 @@ void setup()
             break;
     }
 
-    Config.begin();
+    {
+        ProfilePhase phase(WakePhase::CONFIG_LOAD);
+        Config.begin();
+    }
+
+    // The USB power pin is only set up by Config.begin()
+    if (sleptSeconds && !Config.isOnUsbPower()) {
+        recordSleepEnergy(sleptSeconds);
+    }
 
     // Check if configuration is required
     if (!Config.isConfigured()) {
@@ -0,0 +1,116 @@
+#include "profiler.h"
+
+const char* WAKE_PHASE_NAMES[] = {
+    "other",
+    "boot",
+    "configLoad",
+    "wifi",
+    "networkSync",
+    "tzLookup",
+    "ntpSync",
+    "weatherHttp",
+    "weatherParse",
+    "render",
+    "spiUpload",
+    "panelRefresh",
+    "sleep",
+};
+static_assert(sizeof(WAKE_PHASE_NAMES) / sizeof(*WAKE_PHASE_NAMES) == WAKE_PHASE_COUNT, "Every WakePhase needs a name");
+
+const char* WAKE_SYNC_NAMES[] = {
+    "tzLookup",
+    "ntpSync",
+    "weather",
+};
+static_assert(sizeof(WAKE_SYNC_NAMES) / sizeof(*WAKE_SYNC_NAMES) == WAKE_SYNC_COUNT, "Every WakeSync needs a name");
+
+RTC_DATA_ATTR WakeProfile wakeProfiles[WAKE_PROFILE_COUNT];
+/**
+ * Index in wakeProfiles where the next wake will be saved
+ */
+RTC_DATA_ATTR uint8_t nextWakeProfile = 0;
+RTC_DATA_ATTR uint8_t wakeProfileCount = 0;
+
+/**
+ * The wake being profiled right now, or nullptr if profiling hasn't started
+ */
+static WakeProfile *currentWakeProfile = nullptr;
+static WakePhase currentPhase = WakePhase::OTHER;
+static unsigned long currentPhaseStart = 0;
+/**
+ * Whether this is the task that's being profiled
+ */
+static thread_local bool profiledTask = false;
+
+static WakePhase switchPhase(WakePhase phase)
+{
+    const WakePhase previous = currentPhase;
+    const unsigned long now = micros();
+    if (currentWakeProfile) {
+        currentWakeProfile->phaseMicros[static_cast<size_t>(currentPhase)] += now - currentPhaseStart;
+    }
+    currentPhase = phase;
+    currentPhaseStart = now;
+    return previous;
+}
+
+void profilerBegin(time_t wakeTime, uint8_t wakeupCause)
+{
+    currentWakeProfile = &wakeProfiles[nextWakeProfile];
+    memset(currentWakeProfile, 0, sizeof(WakeProfile));
+    currentWakeProfile->wakeTime = wakeTime;
+    currentWakeProfile->wakeupCause = wakeupCause;
+    profiledTask = true;
+
+    currentPhase = WakePhase::OTHER;
+    currentPhaseStart = micros();
+    currentWakeProfile->phaseMicros[static_cast<size_t>(WakePhase::BOOT)] = currentPhaseStart;
+}
+
+const WakeProfile* profilerEnd(uint32_t sleepSeconds)
+{
+    if (!currentWakeProfile) {
+        return nullptr;
+    }
+    switchPhase(currentPhase);
+    const WakeProfile *profile = currentWakeProfile;
+    currentWakeProfile->sleepSeconds = sleepSeconds;
+    currentWakeProfile = nullptr;
+
+    nextWakeProfile = (nextWakeProfile + 1) % WAKE_PROFILE_COUNT;
+    if (wakeProfileCount < WAKE_PROFILE_COUNT) {
+        ++wakeProfileCount;
+    }
+    return profile;
+}
+
+void profilerRecordSync(WakeSync sync, uint32_t micros)
+{
+    if (currentWakeProfile) {
+        currentWakeProfile->syncMicros[static_cast<size_t>(sync)] = micros;
+    }
+}
+
+size_t getWakeProfileCount()
+{
+    return wakeProfileCount;
+}
+
+const WakeProfile& getWakeProfile(size_t i)
+{
+    return wakeProfiles[(nextWakeProfile + WAKE_PROFILE_COUNT - wakeProfileCount + i) % WAKE_PROFILE_COUNT];
+}
+
+ProfilePhase::ProfilePhase(WakePhase phase) : _active(profiledTask)
+{
+    if (_active) {
+        _previous = switchPhase(phase);
+    }
+}
+
+ProfilePhase::~ProfilePhase()
+{
+    if (_active) {
+        switchPhase(_previous);
+    }
+}
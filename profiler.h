@@ -0,0 +1,104 @@
+#include "global.h"
+
+#ifndef PORTALCALENDAR_PROFILER_H
+#define PORTALCALENDAR_PROFILER_H
+
+/**
+ * The parts of a wake cycle that get timed. Time is only counted towards one phase at a time, so when phases are
+ * nested (like SPI_UPLOAD inside PANEL_REFRESH inside RENDER) the outer phase doesn't include the inner one.
+ */
+enum class WakePhase : uint8_t
+{
+    OTHER = 0,      // Anything that isn't part of another phase
+    BOOT,           // From when the app started until setup() began profiling
+    CONFIG_LOAD,
+    WIFI,           // Connecting to and shutting down Wi-Fi
+    NETWORK_SYNC,   // Waiting for the timezone, NTP and weather syncs when they run at the same time
+    TZ_LOOKUP,
+    NTP_SYNC,
+    WEATHER_HTTP,
+    WEATHER_PARSE,  // Includes receiving the response body, since it's parsed as it's streamed in
+    RENDER,
+    SPI_UPLOAD,
+    PANEL_REFRESH,
+    SLEEP,          // Preparing for deep sleep
+    COUNT,          // Not a phase, must stay last
+};
+
+#define WAKE_PHASE_COUNT static_cast<size_t>(WakePhase::COUNT)
+
+extern const char* WAKE_PHASE_NAMES[];
+
+/**
+ * Network syncs that can run at the same time during the NETWORK_SYNC phase. Phases only count time on the task that
+ * started profiling, so each sync is also timed on its own.
+ */
+enum class WakeSync : uint8_t
+{
+    TZ_LOOKUP = 0,
+    NTP_SYNC,
+    WEATHER,
+    COUNT,          // Not a sync, must stay last
+};
+
+#define WAKE_SYNC_COUNT static_cast<size_t>(WakeSync::COUNT)
+
+extern const char* WAKE_SYNC_NAMES[];
+
+struct WakeProfile
+{
+    time_t wakeTime;
+    /**
+     * Duration of the sleep that ended this wake, or 0 if the device slept until reset
+     */
+    uint32_t sleepSeconds;
+    uint8_t wakeupCause;
+    uint32_t phaseMicros[WAKE_PHASE_COUNT];
+    /**
+     * How long each sync took from start to finish, or 0 if it didn't run. These overlap each other.
+     */
+    uint32_t syncMicros[WAKE_SYNC_COUNT];
+};
+
+/**
+ * Starts profiling the current wake
+ */
+void profilerBegin(time_t wakeTime, uint8_t wakeupCause);
+
+/**
+ * Finishes profiling the current wake and saves it in RTC memory. Must be called right before deep sleep.
+ * Returns the saved wake, or nullptr if profiling wasn't started.
+ */
+const WakeProfile* profilerEnd(uint32_t sleepSeconds);
+
+/**
+ * Records how long a sync took in the current wake
+ */
+void profilerRecordSync(WakeSync sync, uint32_t micros);
+
+/**
+ * Number of finished wakes that are saved, up to WAKE_PROFILE_COUNT
+ */
+size_t getWakeProfileCount();
+
+/**
+ * Gets a saved wake, 0 being the oldest
+ */
+const WakeProfile& getWakeProfile(size_t i);
+
+/**
+ * Counts the time until it goes out of scope towards a phase, then goes back to the phase that was active before.
+ * Does nothing on any task other than the one that called profilerBegin().
+ */
+class ProfilePhase
+{
+public:
+    ProfilePhase(WakePhase phase);
+    ~ProfilePhase();
+
+private:
+    WakePhase _previous;
+    bool _active;
+};
+
+#endif // PORTALCALENDAR_PROFILER_H
@@ -29,7 +29,7 @@ class Glyph:
         return (self.width, self.height)
 
     def compile(self, data: str) -> str:
-        return "{{ 0x{0.codePoint:04X}, FontGlyph({0.width}, {0.height}, {0.top}, {0.left}, {0.rleBits}, &_{1}_DATA[{0.index}]) }}, // '{0.char}'".format(self, data)
+        return "FontGlyph(0x{0.codePoint:04X}, {0.width}, {0.height}, {0.top}, {0.left}, {0.rleBits}, &_{1}_DATA[{0.index}]), // '{0.char}'".format(self, data)
 
 parser = argparse.ArgumentParser()
 parser.add_argument("font", type=str, help="Name or path of the font to be compiled")
@@ -86,6 +86,9 @@ for codePointRange in codePointRanges:
             outputLines += charOutputLines
             byteCount += charByteCount
 
+# Font::findGlyph does a binary search, so glyphs must be sorted by code point regardless of the order of the ranges
+outputGlyphs.sort(key=lambda glyph : glyph.codePoint)
+
 # Compression ratio here is approximate since it assumes every glyph is the same size
 compressionRatio = round(compressionRatioSum / len(outputGlyphs), 2)
 
@@ -112,10 +115,13 @@ outputFile.writelines([
         *map(lambda x : "    {}\n".format(x), outputLines),
     "};\n\n",
     
+    "const FontGlyph _{}_GLYPHS[] = {{\n".format(fontCName),
+        *map(lambda glyph : "    {}\n".format(glyph.compile(fontCName)), outputGlyphs),
+    "};\n\n",
+
     "const Font {} {{\n".format(fontCName),
-    "    .glyphs={\n",
-            *map(lambda glyph : "        {}\n".format(glyph.compile(fontCName)), outputGlyphs),
-    "    },\n",
+    "    .glyphs=_{}_GLYPHS,\n".format(fontCName),
+    "    .glyphCount=sizeof(_{}_GLYPHS) / sizeof(FontGlyph),\n".format(fontCName),
     "    .fgColor=0b{:02b},\n".format(pixelMap[fgColor]),
     "    .bgColor=0b{:02b},\n".format(pixelMap[bgColor]),
     "    .ascent={},\n".format(ascent),
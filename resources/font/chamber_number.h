@@ -876,19 +876,22 @@ const uint8_t _FONT_CHAMBER_NUMBER_DATA[] = {
     0x40,0x81,0xD7,0x81,0x40,0x3F,0x15,0x41,0x82,0xC9,0x82,0x42,0x3F,0x3F,0x1B,
 };
 
+const FontGlyph _FONT_CHAMBER_NUMBER_GLYPHS[] = {
+    FontGlyph(0x0030, 111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[0]), // '0'
+    FontGlyph(0x0031, 111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[1963]), // '1'
+    FontGlyph(0x0032, 111, 293, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[3429]), // '2'
+    FontGlyph(0x0033, 111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[4846]), // '3'
+    FontGlyph(0x0034, 111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[6516]), // '4'
+    FontGlyph(0x0035, 111, 292, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[8322]), // '5'
+    FontGlyph(0x0036, 111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[10024]), // '6'
+    FontGlyph(0x0037, 111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[11863]), // '7'
+    FontGlyph(0x0038, 111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[13141]), // '8'
+    FontGlyph(0x0039, 111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[15051]), // '9'
+};
+
 const Font FONT_CHAMBER_NUMBER {
-    .glyphs={
-        { 0x0030, FontGlyph(111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[0]) }, // '0'
-        { 0x0031, FontGlyph(111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[1963]) }, // '1'
-        { 0x0032, FontGlyph(111, 293, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[3429]) }, // '2'
-        { 0x0033, FontGlyph(111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[4846]) }, // '3'
-        { 0x0034, FontGlyph(111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[6516]) }, // '4'
-        { 0x0035, FontGlyph(111, 292, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[8322]) }, // '5'
-        { 0x0036, FontGlyph(111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[10024]) }, // '6'
-        { 0x0037, FontGlyph(111, 291, 61, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[11863]) }, // '7'
-        { 0x0038, FontGlyph(111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[13141]) }, // '8'
-        { 0x0039, FontGlyph(111, 294, 59, 0, 6, &_FONT_CHAMBER_NUMBER_DATA[15051]) }, // '9'
-    },
+    .glyphs=_FONT_CHAMBER_NUMBER_GLYPHS,
+    .glyphCount=sizeof(_FONT_CHAMBER_NUMBER_GLYPHS) / sizeof(FontGlyph),
     .fgColor=0b11,
     .bgColor=0b00,
     .ascent=350,
@@ -1,41 +1,71 @@
-#include <unordered_map>
 #include "../image.h"
 
 #ifndef PORTALCALENDAR_FONT_H
 #define PORTALCALENDAR_FONT_H
 
 struct FontGlyph : Image {
-    FontGlyph(uint16_t width, uint16_t height, uint16_t top, uint16_t left, uint8_t rleBits, const uint8_t *data):
+    constexpr FontGlyph(uint16_t codePoint, uint16_t width, uint16_t height, int16_t top, int16_t left, uint8_t rleBits, const uint8_t *data):
         Image(width, height, rleBits, data),
+        codePoint(codePoint),
         top(top),
         left(left)
     { }
+    const uint16_t codePoint;
     const int16_t top;
     const int16_t left;
 };
 
 struct Font {
-    const std::unordered_map<uint16_t, const FontGlyph> glyphs;
+    /**
+     * Glyphs sorted by code point. This is a constant array so it lives in flash and needs no initialization at boot.
+     */
+    const FontGlyph *glyphs;
+    const uint16_t glyphCount;
     const uint8_t fgColor;
     const uint8_t bgColor;
     const uint16_t ascent;
     const uint16_t descent;
     const uint16_t spaceWidth;
 
-    const FontGlyph getGlyph(uint16_t cp) const
+    /**
+     * Gets the glyph for a code point, or the replacement character if the font doesn't have it
+     */
+    const FontGlyph& getGlyph(uint16_t cp) const
     {
-        auto iterator = glyphs.find(cp);
-        if (iterator != glyphs.cend()) {
-            return iterator->second;
+        const FontGlyph *glyph = findGlyph(cp);
+        if (glyph) {
+            return *glyph;
         }
-        iterator = glyphs.find(0xFFFD);
-        if (iterator != glyphs.cend()) {
-            return iterator->second;
+        glyph = findGlyph(0xFFFD);
+        if (glyph) {
+            return *glyph;
         }
         // No replacement glyph included in the font, but we still have to return something.
         // This code should never be hit.
-        return glyphs.cbegin()->second;
+        return glyphs[0];
     };
+
+    /**
+     * Finds the glyph for a code point, returns nullptr if the font doesn't have it.
+     * Fonts usually start with a contiguous ASCII range, so try indexing directly by offset before falling back to a binary search.
+     */
+    const FontGlyph* findGlyph(uint16_t cp) const
+    {
+        const uint16_t offset = cp - glyphs[0].codePoint;
+        if (cp >= glyphs[0].codePoint && offset < glyphCount && glyphs[offset].codePoint == cp) {
+            return &glyphs[offset];
+        }
+        uint16_t low = 0, high = glyphCount;
+        while (low < high) {
+            const uint16_t mid = (low + high) / 2;
+            if (glyphs[mid].codePoint < cp) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low < glyphCount && glyphs[low].codePoint == cp ? &glyphs[low] : nullptr;
+    }
 };
 
 #endif // PORTALCALENDAR_FONT_H
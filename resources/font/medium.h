@@ -430,87 +430,90 @@ const uint8_t _FONT_MEDIUM_DATA[] = {
     0x03,0x10,0x19,0x03,0x10,0x19,0x03,0x10,0x19,0x03,0x10,0x1A,0x0F,0x20,0x3C,0x90,
 };
 
+const FontGlyph _FONT_MEDIUM_GLYPHS[] = {
+    FontGlyph(0x0021, 12, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[0]), // '!'
+    FontGlyph(0x002E, 9, 4, 25, 0, 2, &_FONT_MEDIUM_DATA[46]), // '.'
+    FontGlyph(0x002F, 13, 24, 8, 0, 4, &_FONT_MEDIUM_DATA[53]), // '/'
+    FontGlyph(0x0030, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[113]), // '0'
+    FontGlyph(0x0031, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[182]), // '1'
+    FontGlyph(0x0032, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[245]), // '2'
+    FontGlyph(0x0033, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[307]), // '3'
+    FontGlyph(0x0034, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[371]), // '4'
+    FontGlyph(0x0035, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[436]), // '5'
+    FontGlyph(0x0036, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[500]), // '6'
+    FontGlyph(0x0037, 17, 20, 9, 0, 4, &_FONT_MEDIUM_DATA[567]), // '7'
+    FontGlyph(0x0038, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[615]), // '8'
+    FontGlyph(0x0039, 17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[686]), // '9'
+    FontGlyph(0x003A, 9, 15, 14, 0, 4, &_FONT_MEDIUM_DATA[753]), // ':'
+    FontGlyph(0x003B, 9, 18, 14, 0, 2, &_FONT_MEDIUM_DATA[771]), // ';'
+    FontGlyph(0x003C, 17, 15, 14, 0, 4, &_FONT_MEDIUM_DATA[800]), // '<'
+    FontGlyph(0x003D, 17, 12, 17, 0, 4, &_FONT_MEDIUM_DATA[848]), // '='
+    FontGlyph(0x003E, 17, 15, 14, 0, 2, &_FONT_MEDIUM_DATA[867]), // '>'
+    FontGlyph(0x003F, 15, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[916]), // '?'
+    FontGlyph(0x0040, 28, 25, 8, 0, 2, &_FONT_MEDIUM_DATA[973]), // '@'
+    FontGlyph(0x0041, 21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1123]), // 'A'
+    FontGlyph(0x0042, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1205]), // 'B'
+    FontGlyph(0x0043, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1283]), // 'C'
+    FontGlyph(0x0044, 21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1359]), // 'D'
+    FontGlyph(0x0045, 18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1447]), // 'E'
+    FontGlyph(0x0046, 17, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1501]), // 'F'
+    FontGlyph(0x0047, 23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1546]), // 'G'
+    FontGlyph(0x0048, 21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1637]), // 'H'
+    FontGlyph(0x0049, 9, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1709]), // 'I'
+    FontGlyph(0x004A, 17, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1741]), // 'J'
+    FontGlyph(0x004B, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1807]), // 'K'
+    FontGlyph(0x004C, 17, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1887]), // 'L'
+    FontGlyph(0x004D, 27, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1932]), // 'M'
+    FontGlyph(0x004E, 23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2064]), // 'N'
+    FontGlyph(0x004F, 23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2148]), // 'O'
+    FontGlyph(0x0050, 18, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2239]), // 'P'
+    FontGlyph(0x0051, 23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2310]), // 'Q'
+    FontGlyph(0x0052, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2400]), // 'R'
+    FontGlyph(0x0053, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2479]), // 'S'
+    FontGlyph(0x0054, 18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[2560]), // 'T'
+    FontGlyph(0x0055, 23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2621]), // 'U'
+    FontGlyph(0x0056, 21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2713]), // 'V'
+    FontGlyph(0x0057, 29, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2796]), // 'W'
+    FontGlyph(0x0058, 21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2923]), // 'X'
+    FontGlyph(0x0059, 20, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[3005]), // 'Y'
+    FontGlyph(0x005A, 18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[3079]), // 'Z'
+    FontGlyph(0x00C0, 21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3133]), // 'À'
+    FontGlyph(0x00C1, 21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3232]), // 'Á'
+    FontGlyph(0x00C2, 21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3328]), // 'Â'
+    FontGlyph(0x00C3, 21, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[3426]), // 'Ã'
+    FontGlyph(0x00C4, 21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3534]), // 'Ä'
+    FontGlyph(0x00C5, 21, 29, 0, 0, 4, &_FONT_MEDIUM_DATA[3632]), // 'Å'
+    FontGlyph(0x00C6, 30, 21, 8, -1, 4, &_FONT_MEDIUM_DATA[3742]), // 'Æ'
+    FontGlyph(0x00C7, 20, 27, 8, 0, 2, &_FONT_MEDIUM_DATA[3833]), // 'Ç'
+    FontGlyph(0x00C8, 18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3933]), // 'È'
+    FontGlyph(0x00C9, 18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3999]), // 'É'
+    FontGlyph(0x00CA, 18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[4063]), // 'Ê'
+    FontGlyph(0x00CB, 18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[4132]), // 'Ë'
+    FontGlyph(0x00CC, 10, 27, 2, -1, 2, &_FONT_MEDIUM_DATA[4206]), // 'Ì'
+    FontGlyph(0x00CD, 10, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4259]), // 'Í'
+    FontGlyph(0x00CE, 11, 27, 2, -1, 2, &_FONT_MEDIUM_DATA[4312]), // 'Î'
+    FontGlyph(0x00CF, 9, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4367]), // 'Ï'
+    FontGlyph(0x00D0, 22, 21, 8, -1, 2, &_FONT_MEDIUM_DATA[4409]), // 'Ð'
+    FontGlyph(0x00D1, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4500]), // 'Ñ'
+    FontGlyph(0x00D2, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4611]), // 'Ò'
+    FontGlyph(0x00D3, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4722]), // 'Ó'
+    FontGlyph(0x00D4, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4834]), // 'Ô'
+    FontGlyph(0x00D5, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4947]), // 'Õ'
+    FontGlyph(0x00D6, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5065]), // 'Ö'
+    FontGlyph(0x00D8, 23, 23, 7, 0, 2, &_FONT_MEDIUM_DATA[5176]), // 'Ø'
+    FontGlyph(0x00D9, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5287]), // 'Ù'
+    FontGlyph(0x00DA, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5399]), // 'Ú'
+    FontGlyph(0x00DB, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5512]), // 'Û'
+    FontGlyph(0x00DC, 23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5626]), // 'Ü'
+    FontGlyph(0x00DD, 20, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[5738]), // 'Ý'
+    FontGlyph(0x00DE, 18, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[5824]), // 'Þ'
+    FontGlyph(0x00DF, 20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[5895]), // 'ß'
+    FontGlyph(0xFFFD, 22, 19, 10, 0, 4, &_FONT_MEDIUM_DATA[5988]), // '�'
+};
+
 const Font FONT_MEDIUM {
-    .glyphs={
-        { 0x0021, FontGlyph(12, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[0]) }, // '!'
-        { 0x002E, FontGlyph(9, 4, 25, 0, 2, &_FONT_MEDIUM_DATA[46]) }, // '.'
-        { 0x002F, FontGlyph(13, 24, 8, 0, 4, &_FONT_MEDIUM_DATA[53]) }, // '/'
-        { 0x0030, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[113]) }, // '0'
-        { 0x0031, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[182]) }, // '1'
-        { 0x0032, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[245]) }, // '2'
-        { 0x0033, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[307]) }, // '3'
-        { 0x0034, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[371]) }, // '4'
-        { 0x0035, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[436]) }, // '5'
-        { 0x0036, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[500]) }, // '6'
-        { 0x0037, FontGlyph(17, 20, 9, 0, 4, &_FONT_MEDIUM_DATA[567]) }, // '7'
-        { 0x0038, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[615]) }, // '8'
-        { 0x0039, FontGlyph(17, 20, 9, 0, 2, &_FONT_MEDIUM_DATA[686]) }, // '9'
-        { 0x003A, FontGlyph(9, 15, 14, 0, 4, &_FONT_MEDIUM_DATA[753]) }, // ':'
-        { 0x003B, FontGlyph(9, 18, 14, 0, 2, &_FONT_MEDIUM_DATA[771]) }, // ';'
-        { 0x003C, FontGlyph(17, 15, 14, 0, 4, &_FONT_MEDIUM_DATA[800]) }, // '<'
-        { 0x003D, FontGlyph(17, 12, 17, 0, 4, &_FONT_MEDIUM_DATA[848]) }, // '='
-        { 0x003E, FontGlyph(17, 15, 14, 0, 2, &_FONT_MEDIUM_DATA[867]) }, // '>'
-        { 0x003F, FontGlyph(15, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[916]) }, // '?'
-        { 0x0040, FontGlyph(28, 25, 8, 0, 2, &_FONT_MEDIUM_DATA[973]) }, // '@'
-        { 0x0041, FontGlyph(21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1123]) }, // 'A'
-        { 0x0042, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1205]) }, // 'B'
-        { 0x0043, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1283]) }, // 'C'
-        { 0x0044, FontGlyph(21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1359]) }, // 'D'
-        { 0x0045, FontGlyph(18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1447]) }, // 'E'
-        { 0x0046, FontGlyph(17, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1501]) }, // 'F'
-        { 0x0047, FontGlyph(23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1546]) }, // 'G'
-        { 0x0048, FontGlyph(21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1637]) }, // 'H'
-        { 0x0049, FontGlyph(9, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1709]) }, // 'I'
-        { 0x004A, FontGlyph(17, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1741]) }, // 'J'
-        { 0x004B, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1807]) }, // 'K'
-        { 0x004C, FontGlyph(17, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[1887]) }, // 'L'
-        { 0x004D, FontGlyph(27, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[1932]) }, // 'M'
-        { 0x004E, FontGlyph(23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2064]) }, // 'N'
-        { 0x004F, FontGlyph(23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2148]) }, // 'O'
-        { 0x0050, FontGlyph(18, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2239]) }, // 'P'
-        { 0x0051, FontGlyph(23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2310]) }, // 'Q'
-        { 0x0052, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2400]) }, // 'R'
-        { 0x0053, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2479]) }, // 'S'
-        { 0x0054, FontGlyph(18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[2560]) }, // 'T'
-        { 0x0055, FontGlyph(23, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2621]) }, // 'U'
-        { 0x0056, FontGlyph(21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2713]) }, // 'V'
-        { 0x0057, FontGlyph(29, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2796]) }, // 'W'
-        { 0x0058, FontGlyph(21, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[2923]) }, // 'X'
-        { 0x0059, FontGlyph(20, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[3005]) }, // 'Y'
-        { 0x005A, FontGlyph(18, 21, 8, 0, 4, &_FONT_MEDIUM_DATA[3079]) }, // 'Z'
-        { 0x00C0, FontGlyph(21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3133]) }, // 'À'
-        { 0x00C1, FontGlyph(21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3232]) }, // 'Á'
-        { 0x00C2, FontGlyph(21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3328]) }, // 'Â'
-        { 0x00C3, FontGlyph(21, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[3426]) }, // 'Ã'
-        { 0x00C4, FontGlyph(21, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3534]) }, // 'Ä'
-        { 0x00C5, FontGlyph(21, 29, 0, 0, 4, &_FONT_MEDIUM_DATA[3632]) }, // 'Å'
-        { 0x00C6, FontGlyph(30, 21, 8, -1, 4, &_FONT_MEDIUM_DATA[3742]) }, // 'Æ'
-        { 0x00C7, FontGlyph(20, 27, 8, 0, 2, &_FONT_MEDIUM_DATA[3833]) }, // 'Ç'
-        { 0x00C8, FontGlyph(18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3933]) }, // 'È'
-        { 0x00C9, FontGlyph(18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[3999]) }, // 'É'
-        { 0x00CA, FontGlyph(18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[4063]) }, // 'Ê'
-        { 0x00CB, FontGlyph(18, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[4132]) }, // 'Ë'
-        { 0x00CC, FontGlyph(10, 27, 2, -1, 2, &_FONT_MEDIUM_DATA[4206]) }, // 'Ì'
-        { 0x00CD, FontGlyph(10, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4259]) }, // 'Í'
-        { 0x00CE, FontGlyph(11, 27, 2, -1, 2, &_FONT_MEDIUM_DATA[4312]) }, // 'Î'
-        { 0x00CF, FontGlyph(9, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4367]) }, // 'Ï'
-        { 0x00D0, FontGlyph(22, 21, 8, -1, 2, &_FONT_MEDIUM_DATA[4409]) }, // 'Ð'
-        { 0x00D1, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4500]) }, // 'Ñ'
-        { 0x00D2, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4611]) }, // 'Ò'
-        { 0x00D3, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4722]) }, // 'Ó'
-        { 0x00D4, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4834]) }, // 'Ô'
-        { 0x00D5, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[4947]) }, // 'Õ'
-        { 0x00D6, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5065]) }, // 'Ö'
-        { 0x00D8, FontGlyph(23, 23, 7, 0, 2, &_FONT_MEDIUM_DATA[5176]) }, // 'Ø'
-        { 0x00D9, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5287]) }, // 'Ù'
-        { 0x00DA, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5399]) }, // 'Ú'
-        { 0x00DB, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5512]) }, // 'Û'
-        { 0x00DC, FontGlyph(23, 27, 2, 0, 2, &_FONT_MEDIUM_DATA[5626]) }, // 'Ü'
-        { 0x00DD, FontGlyph(20, 27, 2, 0, 4, &_FONT_MEDIUM_DATA[5738]) }, // 'Ý'
-        { 0x00DE, FontGlyph(18, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[5824]) }, // 'Þ'
-        { 0x00DF, FontGlyph(20, 21, 8, 0, 2, &_FONT_MEDIUM_DATA[5895]) }, // 'ß'
-        { 0xFFFD, FontGlyph(22, 19, 10, 0, 4, &_FONT_MEDIUM_DATA[5988]) }, // '�'
-    },
+    .glyphs=_FONT_MEDIUM_GLYPHS,
+    .glyphCount=sizeof(_FONT_MEDIUM_GLYPHS) / sizeof(FontGlyph),
     .fgColor=0b11,
     .bgColor=0b00,
     .ascent=28,
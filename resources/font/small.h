@@ -705,199 +705,202 @@ const uint8_t _FONT_SMALL_DATA[] = {
     0x30,
 };
 
+const FontGlyph _FONT_SMALL_GLYPHS[] = {
+    FontGlyph(0x0021, 6, 19, 5, 0, 0, &_FONT_SMALL_DATA[0]), // '!'
+    FontGlyph(0x0022, 8, 19, 5, 0, 2, &_FONT_SMALL_DATA[29]), // '"'
+    FontGlyph(0x0023, 10, 19, 5, 0, 0, &_FONT_SMALL_DATA[57]), // '#'
+    FontGlyph(0x0024, 10, 23, 3, 0, 2, &_FONT_SMALL_DATA[105]), // '$'
+    FontGlyph(0x0025, 16, 19, 5, 0, 0, &_FONT_SMALL_DATA[160]), // '%'
+    FontGlyph(0x0026, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[236]), // '&'
+    FontGlyph(0x0027, 5, 19, 5, 0, 2, &_FONT_SMALL_DATA[289]), // '''
+    FontGlyph(0x0028, 7, 23, 5, 0, 2, &_FONT_SMALL_DATA[307]), // '('
+    FontGlyph(0x0029, 6, 23, 5, 0, 0, &_FONT_SMALL_DATA[349]), // ')'
+    FontGlyph(0x002A, 8, 19, 5, 0, 2, &_FONT_SMALL_DATA[384]), // '*'
+    FontGlyph(0x002B, 15, 13, 11, 0, 2, &_FONT_SMALL_DATA[415]), // '+'
+    FontGlyph(0x002C, 5, 6, 20, 0, 2, &_FONT_SMALL_DATA[453]), // ','
+    FontGlyph(0x002D, 8, 8, 16, 0, 2, &_FONT_SMALL_DATA[461]), // '-'
+    FontGlyph(0x002E, 5, 4, 20, 0, 0, &_FONT_SMALL_DATA[472]), // '.'
+    FontGlyph(0x002F, 10, 19, 5, -1, 2, &_FONT_SMALL_DATA[477]), // '/'
+    FontGlyph(0x0030, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[518]), // '0'
+    FontGlyph(0x0031, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[567]), // '1'
+    FontGlyph(0x0032, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[606]), // '2'
+    FontGlyph(0x0033, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[650]), // '3'
+    FontGlyph(0x0034, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[697]), // '4'
+    FontGlyph(0x0035, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[746]), // '5'
+    FontGlyph(0x0036, 10, 19, 5, 0, 0, &_FONT_SMALL_DATA[789]), // '6'
+    FontGlyph(0x0037, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[837]), // '7'
+    FontGlyph(0x0038, 10, 19, 5, 0, 0, &_FONT_SMALL_DATA[877]), // '8'
+    FontGlyph(0x0039, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[925]), // '9'
+    FontGlyph(0x003A, 5, 13, 11, 0, 2, &_FONT_SMALL_DATA[974]), // ':'
+    FontGlyph(0x003B, 5, 15, 11, 0, 2, &_FONT_SMALL_DATA[989]), // ';'
+    FontGlyph(0x003C, 15, 14, 10, 0, 2, &_FONT_SMALL_DATA[1006]), // '<'
+    FontGlyph(0x003D, 15, 11, 13, 0, 4, &_FONT_SMALL_DATA[1049]), // '='
+    FontGlyph(0x003E, 15, 14, 10, 0, 2, &_FONT_SMALL_DATA[1063]), // '>'
+    FontGlyph(0x003F, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1103]), // '?'
+    FontGlyph(0x0040, 20, 19, 5, 0, 0, &_FONT_SMALL_DATA[1146]), // '@'
+    FontGlyph(0x0041, 12, 19, 5, 0, 2, &_FONT_SMALL_DATA[1241]), // 'A'
+    FontGlyph(0x0042, 10, 19, 5, 0, 0, &_FONT_SMALL_DATA[1299]), // 'B'
+    FontGlyph(0x0043, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[1347]), // 'C'
+    FontGlyph(0x0044, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1392]), // 'D'
+    FontGlyph(0x0045, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1445]), // 'E'
+    FontGlyph(0x0046, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1483]), // 'F'
+    FontGlyph(0x0047, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1521]), // 'G'
+    FontGlyph(0x0048, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1570]), // 'H'
+    FontGlyph(0x0049, 5, 19, 5, 0, 0, &_FONT_SMALL_DATA[1623]), // 'I'
+    FontGlyph(0x004A, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[1647]), // 'J'
+    FontGlyph(0x004B, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1690]), // 'K'
+    FontGlyph(0x004C, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1743]), // 'L'
+    FontGlyph(0x004D, 15, 19, 5, 0, 0, &_FONT_SMALL_DATA[1781]), // 'M'
+    FontGlyph(0x004E, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1853]), // 'N'
+    FontGlyph(0x004F, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1906]), // 'O'
+    FontGlyph(0x0050, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[1959]), // 'P'
+    FontGlyph(0x0051, 12, 19, 5, 0, 0, &_FONT_SMALL_DATA[2006]), // 'Q'
+    FontGlyph(0x0052, 10, 19, 5, 0, 0, &_FONT_SMALL_DATA[2063]), // 'R'
+    FontGlyph(0x0053, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2111]), // 'S'
+    FontGlyph(0x0054, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2158]), // 'T'
+    FontGlyph(0x0055, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[2195]), // 'U'
+    FontGlyph(0x0056, 12, 19, 5, 0, 2, &_FONT_SMALL_DATA[2248]), // 'V'
+    FontGlyph(0x0057, 17, 19, 5, 0, 0, &_FONT_SMALL_DATA[2306]), // 'W'
+    FontGlyph(0x0058, 12, 19, 5, 0, 2, &_FONT_SMALL_DATA[2387]), // 'X'
+    FontGlyph(0x0059, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[2444]), // 'Y'
+    FontGlyph(0x005A, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2491]), // 'Z'
+    FontGlyph(0x005B, 7, 23, 5, 0, 0, &_FONT_SMALL_DATA[2531]), // '['
+    FontGlyph(0x005C, 10, 19, 5, -1, 2, &_FONT_SMALL_DATA[2572]), // '\'
+    FontGlyph(0x005D, 6, 23, 5, 0, 2, &_FONT_SMALL_DATA[2612]), // ']'
+    FontGlyph(0x005E, 15, 19, 5, 0, 2, &_FONT_SMALL_DATA[2635]), // '^'
+    FontGlyph(0x005F, 13, 4, 23, 0, 4, &_FONT_SMALL_DATA[2689]), // '_'
+    FontGlyph(0x0060, 6, 19, 5, -1, 2, &_FONT_SMALL_DATA[2693]), // '`'
+    FontGlyph(0x0061, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[2711]), // 'a'
+    FontGlyph(0x0062, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2741]), // 'b'
+    FontGlyph(0x0063, 8, 13, 11, 0, 0, &_FONT_SMALL_DATA[2784]), // 'c'
+    FontGlyph(0x0064, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2810]), // 'd'
+    FontGlyph(0x0065, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[2853]), // 'e'
+    FontGlyph(0x0066, 6, 19, 5, 0, 0, &_FONT_SMALL_DATA[2883]), // 'f'
+    FontGlyph(0x0067, 9, 18, 11, 0, 0, &_FONT_SMALL_DATA[2912]), // 'g'
+    FontGlyph(0x0068, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2953]), // 'h'
+    FontGlyph(0x0069, 5, 19, 5, 0, 2, &_FONT_SMALL_DATA[2996]), // 'i'
+    FontGlyph(0x006A, 6, 24, 5, -1, 2, &_FONT_SMALL_DATA[3014]), // 'j'
+    FontGlyph(0x006B, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[3040]), // 'k'
+    FontGlyph(0x006C, 5, 19, 5, 0, 2, &_FONT_SMALL_DATA[3083]), // 'l'
+    FontGlyph(0x006D, 13, 13, 11, 0, 0, &_FONT_SMALL_DATA[3102]), // 'm'
+    FontGlyph(0x006E, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3145]), // 'n'
+    FontGlyph(0x006F, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3175]), // 'o'
+    FontGlyph(0x0070, 9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3205]), // 'p'
+    FontGlyph(0x0071, 9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3246]), // 'q'
+    FontGlyph(0x0072, 6, 13, 11, 0, 0, &_FONT_SMALL_DATA[3287]), // 'r'
+    FontGlyph(0x0073, 8, 13, 11, 0, 0, &_FONT_SMALL_DATA[3307]), // 's'
+    FontGlyph(0x0074, 7, 17, 7, 0, 2, &_FONT_SMALL_DATA[3333]), // 't'
+    FontGlyph(0x0075, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3364]), // 'u'
+    FontGlyph(0x0076, 9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3394]), // 'v'
+    FontGlyph(0x0077, 14, 13, 11, 0, 0, &_FONT_SMALL_DATA[3424]), // 'w'
+    FontGlyph(0x0078, 10, 13, 11, -1, 0, &_FONT_SMALL_DATA[3470]), // 'x'
+    FontGlyph(0x0079, 9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3503]), // 'y'
+    FontGlyph(0x007A, 7, 13, 11, 0, 2, &_FONT_SMALL_DATA[3544]), // 'z'
+    FontGlyph(0x007B, 7, 23, 5, -1, 0, &_FONT_SMALL_DATA[3568]), // '{'
+    FontGlyph(0x007C, 6, 19, 5, 0, 0, &_FONT_SMALL_DATA[3609]), // '|'
+    FontGlyph(0x007D, 7, 23, 5, 0, 2, &_FONT_SMALL_DATA[3638]), // '}'
+    FontGlyph(0x007E, 15, 9, 15, 0, 2, &_FONT_SMALL_DATA[3677]), // '~'
+    FontGlyph(0x00A1, 6, 19, 10, 0, 0, &_FONT_SMALL_DATA[3702]), // '¡'
+    FontGlyph(0x00A2, 10, 17, 9, 0, 0, &_FONT_SMALL_DATA[3731]), // '¢'
+    FontGlyph(0x00A3, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[3774]), // '£'
+    FontGlyph(0x00A4, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[3825]), // '¤'
+    FontGlyph(0x00A5, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[3870]), // '¥'
+    FontGlyph(0x00A6, 6, 19, 5, 0, 0, &_FONT_SMALL_DATA[3919]), // '¦'
+    FontGlyph(0x00A7, 8, 19, 5, 0, 0, &_FONT_SMALL_DATA[3948]), // '§'
+    FontGlyph(0x00A8, 7, 19, 5, -1, 2, &_FONT_SMALL_DATA[3986]), // '¨'
+    FontGlyph(0x00A9, 20, 19, 5, 0, 0, &_FONT_SMALL_DATA[4008]), // '©'
+    FontGlyph(0x00AA, 6, 19, 5, 0, 2, &_FONT_SMALL_DATA[4103]), // 'ª'
+    FontGlyph(0x00AB, 9, 12, 12, 0, 0, &_FONT_SMALL_DATA[4131]), // '«'
+    FontGlyph(0x00AC, 15, 11, 13, 0, 4, &_FONT_SMALL_DATA[4158]), // '¬'
+    FontGlyph(0x00AD, 1, 1, 23, 0, 2, &_FONT_SMALL_DATA[4181]), // '­'
+    FontGlyph(0x00AE, 20, 19, 5, 0, 0, &_FONT_SMALL_DATA[4182]), // '®'
+    FontGlyph(0x00AF, 9, 18, 6, -2, 2, &_FONT_SMALL_DATA[4277]), // '¯'
+    FontGlyph(0x00B0, 11, 19, 5, 0, 2, &_FONT_SMALL_DATA[4299]), // '°'
+    FontGlyph(0x00B1, 15, 13, 11, 0, 4, &_FONT_SMALL_DATA[4337]), // '±'
+    FontGlyph(0x00B2, 7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4370]), // '²'
+    FontGlyph(0x00B3, 7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4400]), // '³'
+    FontGlyph(0x00B4, 6, 19, 5, 0, 2, &_FONT_SMALL_DATA[4434]), // '´'
+    FontGlyph(0x00B5, 9, 18, 11, 0, 0, &_FONT_SMALL_DATA[4453]), // 'µ'
+    FontGlyph(0x00B6, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[4494]), // '¶'
+    FontGlyph(0x00B7, 5, 10, 14, 0, 2, &_FONT_SMALL_DATA[4547]), // '·'
+    FontGlyph(0x00B8, 6, 7, 22, 0, 2, &_FONT_SMALL_DATA[4558]), // '¸'
+    FontGlyph(0x00B9, 7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4569]), // '¹'
+    FontGlyph(0x00BA, 7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4592]), // 'º'
+    FontGlyph(0x00BB, 9, 12, 12, 0, 0, &_FONT_SMALL_DATA[4624]), // '»'
+    FontGlyph(0x00BC, 14, 19, 5, 0, 2, &_FONT_SMALL_DATA[4651]), // '¼'
+    FontGlyph(0x00BD, 14, 19, 5, 0, 2, &_FONT_SMALL_DATA[4717]), // '½'
+    FontGlyph(0x00BE, 14, 19, 5, 0, 0, &_FONT_SMALL_DATA[4784]), // '¾'
+    FontGlyph(0x00BF, 9, 19, 10, 0, 2, &_FONT_SMALL_DATA[4851]), // '¿'
+    FontGlyph(0x00C0, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[4893]), // 'À'
+    FontGlyph(0x00C1, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[4963]), // 'Á'
+    FontGlyph(0x00C2, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5033]), // 'Â'
+    FontGlyph(0x00C3, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5104]), // 'Ã'
+    FontGlyph(0x00C4, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5176]), // 'Ä'
+    FontGlyph(0x00C5, 12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5249]), // 'Å'
+    FontGlyph(0x00C6, 16, 19, 5, 0, 2, &_FONT_SMALL_DATA[5320]), // 'Æ'
+    FontGlyph(0x00C7, 10, 24, 5, 0, 2, &_FONT_SMALL_DATA[5389]), // 'Ç'
+    FontGlyph(0x00C8, 9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5445]), // 'È'
+    FontGlyph(0x00C9, 9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5491]), // 'É'
+    FontGlyph(0x00CA, 9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5538]), // 'Ê'
+    FontGlyph(0x00CB, 9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5586]), // 'Ë'
+    FontGlyph(0x00CC, 6, 24, 0, -1, 0, &_FONT_SMALL_DATA[5633]), // 'Ì'
+    FontGlyph(0x00CD, 6, 24, 0, 0, 0, &_FONT_SMALL_DATA[5669]), // 'Í'
+    FontGlyph(0x00CE, 9, 24, 0, -2, 0, &_FONT_SMALL_DATA[5705]), // 'Î'
+    FontGlyph(0x00CF, 7, 24, 0, -1, 0, &_FONT_SMALL_DATA[5759]), // 'Ï'
+    FontGlyph(0x00D0, 11, 19, 5, 0, 0, &_FONT_SMALL_DATA[5801]), // 'Ð'
+    FontGlyph(0x00D1, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5854]), // 'Ñ'
+    FontGlyph(0x00D2, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5920]), // 'Ò'
+    FontGlyph(0x00D3, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5986]), // 'Ó'
+    FontGlyph(0x00D4, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6052]), // 'Ô'
+    FontGlyph(0x00D5, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6118]), // 'Õ'
+    FontGlyph(0x00D6, 11, 23, 1, 0, 0, &_FONT_SMALL_DATA[6184]), // 'Ö'
+    FontGlyph(0x00D7, 15, 13, 11, 0, 2, &_FONT_SMALL_DATA[6248]), // '×'
+    FontGlyph(0x00D8, 11, 21, 4, 0, 0, &_FONT_SMALL_DATA[6295]), // 'Ø'
+    FontGlyph(0x00D9, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6353]), // 'Ù'
+    FontGlyph(0x00DA, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6419]), // 'Ú'
+    FontGlyph(0x00DB, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6485]), // 'Û'
+    FontGlyph(0x00DC, 11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6551]), // 'Ü'
+    FontGlyph(0x00DD, 11, 24, 0, 0, 2, &_FONT_SMALL_DATA[6617]), // 'Ý'
+    FontGlyph(0x00DE, 10, 19, 5, 0, 2, &_FONT_SMALL_DATA[6673]), // 'Þ'
+    FontGlyph(0x00DF, 10, 20, 5, 0, 0, &_FONT_SMALL_DATA[6720]), // 'ß'
+    FontGlyph(0x00E0, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6770]), // 'à'
+    FontGlyph(0x00E1, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6813]), // 'á'
+    FontGlyph(0x00E2, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6856]), // 'â'
+    FontGlyph(0x00E3, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6899]), // 'ã'
+    FontGlyph(0x00E4, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6942]), // 'ä'
+    FontGlyph(0x00E5, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6985]), // 'å'
+    FontGlyph(0x00E6, 13, 13, 11, 0, 0, &_FONT_SMALL_DATA[7028]), // 'æ'
+    FontGlyph(0x00E7, 8, 18, 11, 0, 0, &_FONT_SMALL_DATA[7071]), // 'ç'
+    FontGlyph(0x00E8, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7107]), // 'è'
+    FontGlyph(0x00E9, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7150]), // 'é'
+    FontGlyph(0x00EA, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7193]), // 'ê'
+    FontGlyph(0x00EB, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7236]), // 'ë'
+    FontGlyph(0x00EC, 6, 19, 5, -1, 2, &_FONT_SMALL_DATA[7280]), // 'ì'
+    FontGlyph(0x00ED, 6, 19, 5, 0, 2, &_FONT_SMALL_DATA[7301]), // 'í'
+    FontGlyph(0x00EE, 9, 19, 5, -2, 2, &_FONT_SMALL_DATA[7323]), // 'î'
+    FontGlyph(0x00EF, 7, 19, 5, -1, 2, &_FONT_SMALL_DATA[7354]), // 'ï'
+    FontGlyph(0x00F0, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7383]), // 'ð'
+    FontGlyph(0x00F1, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7426]), // 'ñ'
+    FontGlyph(0x00F2, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7469]), // 'ò'
+    FontGlyph(0x00F3, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7512]), // 'ó'
+    FontGlyph(0x00F4, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7555]), // 'ô'
+    FontGlyph(0x00F5, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7598]), // 'õ'
+    FontGlyph(0x00F6, 9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7641]), // 'ö'
+    FontGlyph(0x00F7, 15, 15, 10, 0, 4, &_FONT_SMALL_DATA[7685]), // '÷'
+    FontGlyph(0x00F8, 9, 16, 9, 0, 0, &_FONT_SMALL_DATA[7714]), // 'ø'
+    FontGlyph(0x00F9, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7750]), // 'ù'
+    FontGlyph(0x00FA, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7793]), // 'ú'
+    FontGlyph(0x00FB, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7836]), // 'û'
+    FontGlyph(0x00FC, 9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7879]), // 'ü'
+    FontGlyph(0x00FD, 9, 24, 5, 0, 0, &_FONT_SMALL_DATA[7922]), // 'ý'
+    FontGlyph(0x00FE, 9, 24, 5, 0, 0, &_FONT_SMALL_DATA[7976]), // 'þ'
+    FontGlyph(0x00FF, 9, 24, 5, 0, 0, &_FONT_SMALL_DATA[8030]), // 'ÿ'
+    FontGlyph(0xFFFD, 5, 1, 23, 0, 2, &_FONT_SMALL_DATA[8084]), // '�'
+};
+
 const Font FONT_SMALL {
-    .glyphs={
-        { 0x0021, FontGlyph(6, 19, 5, 0, 0, &_FONT_SMALL_DATA[0]) }, // '!'
-        { 0x0022, FontGlyph(8, 19, 5, 0, 2, &_FONT_SMALL_DATA[29]) }, // '"'
-        { 0x0023, FontGlyph(10, 19, 5, 0, 0, &_FONT_SMALL_DATA[57]) }, // '#'
-        { 0x0024, FontGlyph(10, 23, 3, 0, 2, &_FONT_SMALL_DATA[105]) }, // '$'
-        { 0x0025, FontGlyph(16, 19, 5, 0, 0, &_FONT_SMALL_DATA[160]) }, // '%'
-        { 0x0026, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[236]) }, // '&'
-        { 0x0027, FontGlyph(5, 19, 5, 0, 2, &_FONT_SMALL_DATA[289]) }, // '''
-        { 0x0028, FontGlyph(7, 23, 5, 0, 2, &_FONT_SMALL_DATA[307]) }, // '('
-        { 0x0029, FontGlyph(6, 23, 5, 0, 0, &_FONT_SMALL_DATA[349]) }, // ')'
-        { 0x002A, FontGlyph(8, 19, 5, 0, 2, &_FONT_SMALL_DATA[384]) }, // '*'
-        { 0x002B, FontGlyph(15, 13, 11, 0, 2, &_FONT_SMALL_DATA[415]) }, // '+'
-        { 0x002C, FontGlyph(5, 6, 20, 0, 2, &_FONT_SMALL_DATA[453]) }, // ','
-        { 0x002D, FontGlyph(8, 8, 16, 0, 2, &_FONT_SMALL_DATA[461]) }, // '-'
-        { 0x002E, FontGlyph(5, 4, 20, 0, 0, &_FONT_SMALL_DATA[472]) }, // '.'
-        { 0x002F, FontGlyph(10, 19, 5, -1, 2, &_FONT_SMALL_DATA[477]) }, // '/'
-        { 0x0030, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[518]) }, // '0'
-        { 0x0031, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[567]) }, // '1'
-        { 0x0032, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[606]) }, // '2'
-        { 0x0033, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[650]) }, // '3'
-        { 0x0034, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[697]) }, // '4'
-        { 0x0035, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[746]) }, // '5'
-        { 0x0036, FontGlyph(10, 19, 5, 0, 0, &_FONT_SMALL_DATA[789]) }, // '6'
-        { 0x0037, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[837]) }, // '7'
-        { 0x0038, FontGlyph(10, 19, 5, 0, 0, &_FONT_SMALL_DATA[877]) }, // '8'
-        { 0x0039, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[925]) }, // '9'
-        { 0x003A, FontGlyph(5, 13, 11, 0, 2, &_FONT_SMALL_DATA[974]) }, // ':'
-        { 0x003B, FontGlyph(5, 15, 11, 0, 2, &_FONT_SMALL_DATA[989]) }, // ';'
-        { 0x003C, FontGlyph(15, 14, 10, 0, 2, &_FONT_SMALL_DATA[1006]) }, // '<'
-        { 0x003D, FontGlyph(15, 11, 13, 0, 4, &_FONT_SMALL_DATA[1049]) }, // '='
-        { 0x003E, FontGlyph(15, 14, 10, 0, 2, &_FONT_SMALL_DATA[1063]) }, // '>'
-        { 0x003F, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1103]) }, // '?'
-        { 0x0040, FontGlyph(20, 19, 5, 0, 0, &_FONT_SMALL_DATA[1146]) }, // '@'
-        { 0x0041, FontGlyph(12, 19, 5, 0, 2, &_FONT_SMALL_DATA[1241]) }, // 'A'
-        { 0x0042, FontGlyph(10, 19, 5, 0, 0, &_FONT_SMALL_DATA[1299]) }, // 'B'
-        { 0x0043, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[1347]) }, // 'C'
-        { 0x0044, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1392]) }, // 'D'
-        { 0x0045, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1445]) }, // 'E'
-        { 0x0046, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1483]) }, // 'F'
-        { 0x0047, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1521]) }, // 'G'
-        { 0x0048, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[1570]) }, // 'H'
-        { 0x0049, FontGlyph(5, 19, 5, 0, 0, &_FONT_SMALL_DATA[1623]) }, // 'I'
-        { 0x004A, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[1647]) }, // 'J'
-        { 0x004B, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1690]) }, // 'K'
-        { 0x004C, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[1743]) }, // 'L'
-        { 0x004D, FontGlyph(15, 19, 5, 0, 0, &_FONT_SMALL_DATA[1781]) }, // 'M'
-        { 0x004E, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1853]) }, // 'N'
-        { 0x004F, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[1906]) }, // 'O'
-        { 0x0050, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[1959]) }, // 'P'
-        { 0x0051, FontGlyph(12, 19, 5, 0, 0, &_FONT_SMALL_DATA[2006]) }, // 'Q'
-        { 0x0052, FontGlyph(10, 19, 5, 0, 0, &_FONT_SMALL_DATA[2063]) }, // 'R'
-        { 0x0053, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2111]) }, // 'S'
-        { 0x0054, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2158]) }, // 'T'
-        { 0x0055, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[2195]) }, // 'U'
-        { 0x0056, FontGlyph(12, 19, 5, 0, 2, &_FONT_SMALL_DATA[2248]) }, // 'V'
-        { 0x0057, FontGlyph(17, 19, 5, 0, 0, &_FONT_SMALL_DATA[2306]) }, // 'W'
-        { 0x0058, FontGlyph(12, 19, 5, 0, 2, &_FONT_SMALL_DATA[2387]) }, // 'X'
-        { 0x0059, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[2444]) }, // 'Y'
-        { 0x005A, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[2491]) }, // 'Z'
-        { 0x005B, FontGlyph(7, 23, 5, 0, 0, &_FONT_SMALL_DATA[2531]) }, // '['
-        { 0x005C, FontGlyph(10, 19, 5, -1, 2, &_FONT_SMALL_DATA[2572]) }, // '\'
-        { 0x005D, FontGlyph(6, 23, 5, 0, 2, &_FONT_SMALL_DATA[2612]) }, // ']'
-        { 0x005E, FontGlyph(15, 19, 5, 0, 2, &_FONT_SMALL_DATA[2635]) }, // '^'
-        { 0x005F, FontGlyph(13, 4, 23, 0, 4, &_FONT_SMALL_DATA[2689]) }, // '_'
-        { 0x0060, FontGlyph(6, 19, 5, -1, 2, &_FONT_SMALL_DATA[2693]) }, // '`'
-        { 0x0061, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[2711]) }, // 'a'
-        { 0x0062, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2741]) }, // 'b'
-        { 0x0063, FontGlyph(8, 13, 11, 0, 0, &_FONT_SMALL_DATA[2784]) }, // 'c'
-        { 0x0064, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2810]) }, // 'd'
-        { 0x0065, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[2853]) }, // 'e'
-        { 0x0066, FontGlyph(6, 19, 5, 0, 0, &_FONT_SMALL_DATA[2883]) }, // 'f'
-        { 0x0067, FontGlyph(9, 18, 11, 0, 0, &_FONT_SMALL_DATA[2912]) }, // 'g'
-        { 0x0068, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[2953]) }, // 'h'
-        { 0x0069, FontGlyph(5, 19, 5, 0, 2, &_FONT_SMALL_DATA[2996]) }, // 'i'
-        { 0x006A, FontGlyph(6, 24, 5, -1, 2, &_FONT_SMALL_DATA[3014]) }, // 'j'
-        { 0x006B, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[3040]) }, // 'k'
-        { 0x006C, FontGlyph(5, 19, 5, 0, 2, &_FONT_SMALL_DATA[3083]) }, // 'l'
-        { 0x006D, FontGlyph(13, 13, 11, 0, 0, &_FONT_SMALL_DATA[3102]) }, // 'm'
-        { 0x006E, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3145]) }, // 'n'
-        { 0x006F, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3175]) }, // 'o'
-        { 0x0070, FontGlyph(9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3205]) }, // 'p'
-        { 0x0071, FontGlyph(9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3246]) }, // 'q'
-        { 0x0072, FontGlyph(6, 13, 11, 0, 0, &_FONT_SMALL_DATA[3287]) }, // 'r'
-        { 0x0073, FontGlyph(8, 13, 11, 0, 0, &_FONT_SMALL_DATA[3307]) }, // 's'
-        { 0x0074, FontGlyph(7, 17, 7, 0, 2, &_FONT_SMALL_DATA[3333]) }, // 't'
-        { 0x0075, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3364]) }, // 'u'
-        { 0x0076, FontGlyph(9, 13, 11, 0, 0, &_FONT_SMALL_DATA[3394]) }, // 'v'
-        { 0x0077, FontGlyph(14, 13, 11, 0, 0, &_FONT_SMALL_DATA[3424]) }, // 'w'
-        { 0x0078, FontGlyph(10, 13, 11, -1, 0, &_FONT_SMALL_DATA[3470]) }, // 'x'
-        { 0x0079, FontGlyph(9, 18, 11, 0, 0, &_FONT_SMALL_DATA[3503]) }, // 'y'
-        { 0x007A, FontGlyph(7, 13, 11, 0, 2, &_FONT_SMALL_DATA[3544]) }, // 'z'
-        { 0x007B, FontGlyph(7, 23, 5, -1, 0, &_FONT_SMALL_DATA[3568]) }, // '{'
-        { 0x007C, FontGlyph(6, 19, 5, 0, 0, &_FONT_SMALL_DATA[3609]) }, // '|'
-        { 0x007D, FontGlyph(7, 23, 5, 0, 2, &_FONT_SMALL_DATA[3638]) }, // '}'
-        { 0x007E, FontGlyph(15, 9, 15, 0, 2, &_FONT_SMALL_DATA[3677]) }, // '~'
-        { 0x00A1, FontGlyph(6, 19, 10, 0, 0, &_FONT_SMALL_DATA[3702]) }, // '¡'
-        { 0x00A2, FontGlyph(10, 17, 9, 0, 0, &_FONT_SMALL_DATA[3731]) }, // '¢'
-        { 0x00A3, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[3774]) }, // '£'
-        { 0x00A4, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[3825]) }, // '¤'
-        { 0x00A5, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[3870]) }, // '¥'
-        { 0x00A6, FontGlyph(6, 19, 5, 0, 0, &_FONT_SMALL_DATA[3919]) }, // '¦'
-        { 0x00A7, FontGlyph(8, 19, 5, 0, 0, &_FONT_SMALL_DATA[3948]) }, // '§'
-        { 0x00A8, FontGlyph(7, 19, 5, -1, 2, &_FONT_SMALL_DATA[3986]) }, // '¨'
-        { 0x00A9, FontGlyph(20, 19, 5, 0, 0, &_FONT_SMALL_DATA[4008]) }, // '©'
-        { 0x00AA, FontGlyph(6, 19, 5, 0, 2, &_FONT_SMALL_DATA[4103]) }, // 'ª'
-        { 0x00AB, FontGlyph(9, 12, 12, 0, 0, &_FONT_SMALL_DATA[4131]) }, // '«'
-        { 0x00AC, FontGlyph(15, 11, 13, 0, 4, &_FONT_SMALL_DATA[4158]) }, // '¬'
-        { 0x00AD, FontGlyph(1, 1, 23, 0, 2, &_FONT_SMALL_DATA[4181]) }, // '­'
-        { 0x00AE, FontGlyph(20, 19, 5, 0, 0, &_FONT_SMALL_DATA[4182]) }, // '®'
-        { 0x00AF, FontGlyph(9, 18, 6, -2, 2, &_FONT_SMALL_DATA[4277]) }, // '¯'
-        { 0x00B0, FontGlyph(11, 19, 5, 0, 2, &_FONT_SMALL_DATA[4299]) }, // '°'
-        { 0x00B1, FontGlyph(15, 13, 11, 0, 4, &_FONT_SMALL_DATA[4337]) }, // '±'
-        { 0x00B2, FontGlyph(7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4370]) }, // '²'
-        { 0x00B3, FontGlyph(7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4400]) }, // '³'
-        { 0x00B4, FontGlyph(6, 19, 5, 0, 2, &_FONT_SMALL_DATA[4434]) }, // '´'
-        { 0x00B5, FontGlyph(9, 18, 11, 0, 0, &_FONT_SMALL_DATA[4453]) }, // 'µ'
-        { 0x00B6, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[4494]) }, // '¶'
-        { 0x00B7, FontGlyph(5, 10, 14, 0, 2, &_FONT_SMALL_DATA[4547]) }, // '·'
-        { 0x00B8, FontGlyph(6, 7, 22, 0, 2, &_FONT_SMALL_DATA[4558]) }, // '¸'
-        { 0x00B9, FontGlyph(7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4569]) }, // '¹'
-        { 0x00BA, FontGlyph(7, 19, 5, 0, 2, &_FONT_SMALL_DATA[4592]) }, // 'º'
-        { 0x00BB, FontGlyph(9, 12, 12, 0, 0, &_FONT_SMALL_DATA[4624]) }, // '»'
-        { 0x00BC, FontGlyph(14, 19, 5, 0, 2, &_FONT_SMALL_DATA[4651]) }, // '¼'
-        { 0x00BD, FontGlyph(14, 19, 5, 0, 2, &_FONT_SMALL_DATA[4717]) }, // '½'
-        { 0x00BE, FontGlyph(14, 19, 5, 0, 0, &_FONT_SMALL_DATA[4784]) }, // '¾'
-        { 0x00BF, FontGlyph(9, 19, 10, 0, 2, &_FONT_SMALL_DATA[4851]) }, // '¿'
-        { 0x00C0, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[4893]) }, // 'À'
-        { 0x00C1, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[4963]) }, // 'Á'
-        { 0x00C2, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5033]) }, // 'Â'
-        { 0x00C3, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5104]) }, // 'Ã'
-        { 0x00C4, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5176]) }, // 'Ä'
-        { 0x00C5, FontGlyph(12, 24, 0, 0, 2, &_FONT_SMALL_DATA[5249]) }, // 'Å'
-        { 0x00C6, FontGlyph(16, 19, 5, 0, 2, &_FONT_SMALL_DATA[5320]) }, // 'Æ'
-        { 0x00C7, FontGlyph(10, 24, 5, 0, 2, &_FONT_SMALL_DATA[5389]) }, // 'Ç'
-        { 0x00C8, FontGlyph(9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5445]) }, // 'È'
-        { 0x00C9, FontGlyph(9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5491]) }, // 'É'
-        { 0x00CA, FontGlyph(9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5538]) }, // 'Ê'
-        { 0x00CB, FontGlyph(9, 24, 0, 0, 2, &_FONT_SMALL_DATA[5586]) }, // 'Ë'
-        { 0x00CC, FontGlyph(6, 24, 0, -1, 0, &_FONT_SMALL_DATA[5633]) }, // 'Ì'
-        { 0x00CD, FontGlyph(6, 24, 0, 0, 0, &_FONT_SMALL_DATA[5669]) }, // 'Í'
-        { 0x00CE, FontGlyph(9, 24, 0, -2, 0, &_FONT_SMALL_DATA[5705]) }, // 'Î'
-        { 0x00CF, FontGlyph(7, 24, 0, -1, 0, &_FONT_SMALL_DATA[5759]) }, // 'Ï'
-        { 0x00D0, FontGlyph(11, 19, 5, 0, 0, &_FONT_SMALL_DATA[5801]) }, // 'Ð'
-        { 0x00D1, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5854]) }, // 'Ñ'
-        { 0x00D2, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5920]) }, // 'Ò'
-        { 0x00D3, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[5986]) }, // 'Ó'
-        { 0x00D4, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6052]) }, // 'Ô'
-        { 0x00D5, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6118]) }, // 'Õ'
-        { 0x00D6, FontGlyph(11, 23, 1, 0, 0, &_FONT_SMALL_DATA[6184]) }, // 'Ö'
-        { 0x00D7, FontGlyph(15, 13, 11, 0, 2, &_FONT_SMALL_DATA[6248]) }, // '×'
-        { 0x00D8, FontGlyph(11, 21, 4, 0, 0, &_FONT_SMALL_DATA[6295]) }, // 'Ø'
-        { 0x00D9, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6353]) }, // 'Ù'
-        { 0x00DA, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6419]) }, // 'Ú'
-        { 0x00DB, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6485]) }, // 'Û'
-        { 0x00DC, FontGlyph(11, 24, 0, 0, 0, &_FONT_SMALL_DATA[6551]) }, // 'Ü'
-        { 0x00DD, FontGlyph(11, 24, 0, 0, 2, &_FONT_SMALL_DATA[6617]) }, // 'Ý'
-        { 0x00DE, FontGlyph(10, 19, 5, 0, 2, &_FONT_SMALL_DATA[6673]) }, // 'Þ'
-        { 0x00DF, FontGlyph(10, 20, 5, 0, 0, &_FONT_SMALL_DATA[6720]) }, // 'ß'
-        { 0x00E0, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6770]) }, // 'à'
-        { 0x00E1, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6813]) }, // 'á'
-        { 0x00E2, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6856]) }, // 'â'
-        { 0x00E3, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6899]) }, // 'ã'
-        { 0x00E4, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6942]) }, // 'ä'
-        { 0x00E5, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[6985]) }, // 'å'
-        { 0x00E6, FontGlyph(13, 13, 11, 0, 0, &_FONT_SMALL_DATA[7028]) }, // 'æ'
-        { 0x00E7, FontGlyph(8, 18, 11, 0, 0, &_FONT_SMALL_DATA[7071]) }, // 'ç'
-        { 0x00E8, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7107]) }, // 'è'
-        { 0x00E9, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7150]) }, // 'é'
-        { 0x00EA, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7193]) }, // 'ê'
-        { 0x00EB, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7236]) }, // 'ë'
-        { 0x00EC, FontGlyph(6, 19, 5, -1, 2, &_FONT_SMALL_DATA[7280]) }, // 'ì'
-        { 0x00ED, FontGlyph(6, 19, 5, 0, 2, &_FONT_SMALL_DATA[7301]) }, // 'í'
-        { 0x00EE, FontGlyph(9, 19, 5, -2, 2, &_FONT_SMALL_DATA[7323]) }, // 'î'
-        { 0x00EF, FontGlyph(7, 19, 5, -1, 2, &_FONT_SMALL_DATA[7354]) }, // 'ï'
-        { 0x00F0, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7383]) }, // 'ð'
-        { 0x00F1, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7426]) }, // 'ñ'
-        { 0x00F2, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7469]) }, // 'ò'
-        { 0x00F3, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7512]) }, // 'ó'
-        { 0x00F4, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7555]) }, // 'ô'
-        { 0x00F5, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7598]) }, // 'õ'
-        { 0x00F6, FontGlyph(9, 19, 5, 0, 2, &_FONT_SMALL_DATA[7641]) }, // 'ö'
-        { 0x00F7, FontGlyph(15, 15, 10, 0, 4, &_FONT_SMALL_DATA[7685]) }, // '÷'
-        { 0x00F8, FontGlyph(9, 16, 9, 0, 0, &_FONT_SMALL_DATA[7714]) }, // 'ø'
-        { 0x00F9, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7750]) }, // 'ù'
-        { 0x00FA, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7793]) }, // 'ú'
-        { 0x00FB, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7836]) }, // 'û'
-        { 0x00FC, FontGlyph(9, 19, 5, 0, 0, &_FONT_SMALL_DATA[7879]) }, // 'ü'
-        { 0x00FD, FontGlyph(9, 24, 5, 0, 0, &_FONT_SMALL_DATA[7922]) }, // 'ý'
-        { 0x00FE, FontGlyph(9, 24, 5, 0, 0, &_FONT_SMALL_DATA[7976]) }, // 'þ'
-        { 0x00FF, FontGlyph(9, 24, 5, 0, 0, &_FONT_SMALL_DATA[8030]) }, // 'ÿ'
-        { 0xFFFD, FontGlyph(5, 1, 23, 0, 2, &_FONT_SMALL_DATA[8084]) }, // '�'
-    },
+    .glyphs=_FONT_SMALL_GLYPHS,
+    .glyphCount=sizeof(_FONT_SMALL_GLYPHS) / sizeof(FontGlyph),
     .fgColor=0b11,
     .bgColor=0b00,
     .ascent=23,
@@ -242,86 +242,89 @@ const uint8_t _FONT_WEATHER_FRAME_DATA[] = {
     0xF0,
 };
 
+const FontGlyph _FONT_WEATHER_FRAME_GLYPHS[] = {
+    FontGlyph(0x002E, 4, 4, 14, 0, 0, &_FONT_WEATHER_FRAME_DATA[0]), // '.'
+    FontGlyph(0x002F, 8, 14, 4, -1, 2, &_FONT_WEATHER_FRAME_DATA[4]), // '/'
+    FontGlyph(0x0030, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[32]), // '0'
+    FontGlyph(0x0031, 8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[60]), // '1'
+    FontGlyph(0x0032, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[88]), // '2'
+    FontGlyph(0x0033, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[116]), // '3'
+    FontGlyph(0x0034, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[144]), // '4'
+    FontGlyph(0x0035, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[172]), // '5'
+    FontGlyph(0x0036, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[200]), // '6'
+    FontGlyph(0x0037, 8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[228]), // '7'
+    FontGlyph(0x0038, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[257]), // '8'
+    FontGlyph(0x0039, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[285]), // '9'
+    FontGlyph(0x003A, 4, 10, 8, 0, 0, &_FONT_WEATHER_FRAME_DATA[313]), // ':'
+    FontGlyph(0x003B, 4, 11, 8, 0, 0, &_FONT_WEATHER_FRAME_DATA[323]), // ';'
+    FontGlyph(0x003C, 12, 10, 8, 0, 2, &_FONT_WEATHER_FRAME_DATA[334]), // '<'
+    FontGlyph(0x003D, 12, 8, 10, 0, 4, &_FONT_WEATHER_FRAME_DATA[361]), // '='
+    FontGlyph(0x003E, 12, 10, 8, 0, 2, &_FONT_WEATHER_FRAME_DATA[370]), // '>'
+    FontGlyph(0x003F, 7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[399]), // '?'
+    FontGlyph(0x0040, 15, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[424]), // '@'
+    FontGlyph(0x0041, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[477]), // 'A'
+    FontGlyph(0x0042, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[509]), // 'B'
+    FontGlyph(0x0043, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[537]), // 'C'
+    FontGlyph(0x0044, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[565]), // 'D'
+    FontGlyph(0x0045, 7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[593]), // 'E'
+    FontGlyph(0x0046, 7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[618]), // 'F'
+    FontGlyph(0x0047, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[643]), // 'G'
+    FontGlyph(0x0048, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[671]), // 'H'
+    FontGlyph(0x0049, 4, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[699]), // 'I'
+    FontGlyph(0x004A, 7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[713]), // 'J'
+    FontGlyph(0x004B, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[738]), // 'K'
+    FontGlyph(0x004C, 7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[770]), // 'L'
+    FontGlyph(0x004D, 11, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[795]), // 'M'
+    FontGlyph(0x004E, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[834]), // 'N'
+    FontGlyph(0x004F, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[866]), // 'O'
+    FontGlyph(0x0050, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[894]), // 'P'
+    FontGlyph(0x0051, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[922]), // 'Q'
+    FontGlyph(0x0052, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[954]), // 'R'
+    FontGlyph(0x0053, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[982]), // 'S'
+    FontGlyph(0x0054, 8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[1010]), // 'T'
+    FontGlyph(0x0055, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1037]), // 'U'
+    FontGlyph(0x0056, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1065]), // 'V'
+    FontGlyph(0x0057, 13, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1097]), // 'W'
+    FontGlyph(0x0058, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1143]), // 'X'
+    FontGlyph(0x0059, 9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1175]), // 'Y'
+    FontGlyph(0x005A, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1207]), // 'Z'
+    FontGlyph(0x00C0, 9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1235]), // 'À'
+    FontGlyph(0x00C1, 9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1276]), // 'Á'
+    FontGlyph(0x00C2, 9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1317]), // 'Â'
+    FontGlyph(0x00C3, 9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1358]), // 'Ã'
+    FontGlyph(0x00C4, 9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1397]), // 'Ä'
+    FontGlyph(0x00C5, 9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1436]), // 'Å'
+    FontGlyph(0x00C6, 12, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[1477]), // 'Æ'
+    FontGlyph(0x00C7, 8, 18, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1520]), // 'Ç'
+    FontGlyph(0x00C8, 7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1556]), // 'È'
+    FontGlyph(0x00C9, 7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1588]), // 'É'
+    FontGlyph(0x00CA, 7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1620]), // 'Ê'
+    FontGlyph(0x00CB, 7, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1652]), // 'Ë'
+    FontGlyph(0x00CC, 5, 18, 0, -1, 0, &_FONT_WEATHER_FRAME_DATA[1682]), // 'Ì'
+    FontGlyph(0x00CD, 5, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1705]), // 'Í'
+    FontGlyph(0x00CE, 6, 18, 0, -1, 0, &_FONT_WEATHER_FRAME_DATA[1728]), // 'Î'
+    FontGlyph(0x00CF, 6, 17, 1, -1, 0, &_FONT_WEATHER_FRAME_DATA[1755]), // 'Ï'
+    FontGlyph(0x00D0, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1781]), // 'Ð'
+    FontGlyph(0x00D1, 9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1809]), // 'Ñ'
+    FontGlyph(0x00D2, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1848]), // 'Ò'
+    FontGlyph(0x00D3, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1884]), // 'Ó'
+    FontGlyph(0x00D4, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1920]), // 'Ô'
+    FontGlyph(0x00D5, 8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1956]), // 'Õ'
+    FontGlyph(0x00D6, 8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1990]), // 'Ö'
+    FontGlyph(0x00D8, 8, 16, 3, 0, 0, &_FONT_WEATHER_FRAME_DATA[2024]), // 'Ø'
+    FontGlyph(0x00D9, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2056]), // 'Ù'
+    FontGlyph(0x00DA, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2092]), // 'Ú'
+    FontGlyph(0x00DB, 8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2128]), // 'Û'
+    FontGlyph(0x00DC, 8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[2164]), // 'Ü'
+    FontGlyph(0x00DD, 9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2198]), // 'Ý'
+    FontGlyph(0x00DE, 8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[2239]), // 'Þ'
+    FontGlyph(0x00DF, 8, 15, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[2267]), // 'ß'
+    FontGlyph(0xFFFD, 4, 1, 17, 0, 2, &_FONT_WEATHER_FRAME_DATA[2297]), // '�'
+};
+
 const Font FONT_WEATHER_FRAME {
-    .glyphs={
-        { 0x002E, FontGlyph(4, 4, 14, 0, 0, &_FONT_WEATHER_FRAME_DATA[0]) }, // '.'
-        { 0x002F, FontGlyph(8, 14, 4, -1, 2, &_FONT_WEATHER_FRAME_DATA[4]) }, // '/'
-        { 0x0030, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[32]) }, // '0'
-        { 0x0031, FontGlyph(8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[60]) }, // '1'
-        { 0x0032, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[88]) }, // '2'
-        { 0x0033, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[116]) }, // '3'
-        { 0x0034, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[144]) }, // '4'
-        { 0x0035, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[172]) }, // '5'
-        { 0x0036, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[200]) }, // '6'
-        { 0x0037, FontGlyph(8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[228]) }, // '7'
-        { 0x0038, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[257]) }, // '8'
-        { 0x0039, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[285]) }, // '9'
-        { 0x003A, FontGlyph(4, 10, 8, 0, 0, &_FONT_WEATHER_FRAME_DATA[313]) }, // ':'
-        { 0x003B, FontGlyph(4, 11, 8, 0, 0, &_FONT_WEATHER_FRAME_DATA[323]) }, // ';'
-        { 0x003C, FontGlyph(12, 10, 8, 0, 2, &_FONT_WEATHER_FRAME_DATA[334]) }, // '<'
-        { 0x003D, FontGlyph(12, 8, 10, 0, 4, &_FONT_WEATHER_FRAME_DATA[361]) }, // '='
-        { 0x003E, FontGlyph(12, 10, 8, 0, 2, &_FONT_WEATHER_FRAME_DATA[370]) }, // '>'
-        { 0x003F, FontGlyph(7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[399]) }, // '?'
-        { 0x0040, FontGlyph(15, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[424]) }, // '@'
-        { 0x0041, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[477]) }, // 'A'
-        { 0x0042, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[509]) }, // 'B'
-        { 0x0043, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[537]) }, // 'C'
-        { 0x0044, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[565]) }, // 'D'
-        { 0x0045, FontGlyph(7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[593]) }, // 'E'
-        { 0x0046, FontGlyph(7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[618]) }, // 'F'
-        { 0x0047, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[643]) }, // 'G'
-        { 0x0048, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[671]) }, // 'H'
-        { 0x0049, FontGlyph(4, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[699]) }, // 'I'
-        { 0x004A, FontGlyph(7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[713]) }, // 'J'
-        { 0x004B, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[738]) }, // 'K'
-        { 0x004C, FontGlyph(7, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[770]) }, // 'L'
-        { 0x004D, FontGlyph(11, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[795]) }, // 'M'
-        { 0x004E, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[834]) }, // 'N'
-        { 0x004F, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[866]) }, // 'O'
-        { 0x0050, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[894]) }, // 'P'
-        { 0x0051, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[922]) }, // 'Q'
-        { 0x0052, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[954]) }, // 'R'
-        { 0x0053, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[982]) }, // 'S'
-        { 0x0054, FontGlyph(8, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[1010]) }, // 'T'
-        { 0x0055, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1037]) }, // 'U'
-        { 0x0056, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1065]) }, // 'V'
-        { 0x0057, FontGlyph(13, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1097]) }, // 'W'
-        { 0x0058, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1143]) }, // 'X'
-        { 0x0059, FontGlyph(9, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1175]) }, // 'Y'
-        { 0x005A, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1207]) }, // 'Z'
-        { 0x00C0, FontGlyph(9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1235]) }, // 'À'
-        { 0x00C1, FontGlyph(9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1276]) }, // 'Á'
-        { 0x00C2, FontGlyph(9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1317]) }, // 'Â'
-        { 0x00C3, FontGlyph(9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1358]) }, // 'Ã'
-        { 0x00C4, FontGlyph(9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1397]) }, // 'Ä'
-        { 0x00C5, FontGlyph(9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1436]) }, // 'Å'
-        { 0x00C6, FontGlyph(12, 14, 4, 0, 2, &_FONT_WEATHER_FRAME_DATA[1477]) }, // 'Æ'
-        { 0x00C7, FontGlyph(8, 18, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1520]) }, // 'Ç'
-        { 0x00C8, FontGlyph(7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1556]) }, // 'È'
-        { 0x00C9, FontGlyph(7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1588]) }, // 'É'
-        { 0x00CA, FontGlyph(7, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1620]) }, // 'Ê'
-        { 0x00CB, FontGlyph(7, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1652]) }, // 'Ë'
-        { 0x00CC, FontGlyph(5, 18, 0, -1, 0, &_FONT_WEATHER_FRAME_DATA[1682]) }, // 'Ì'
-        { 0x00CD, FontGlyph(5, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1705]) }, // 'Í'
-        { 0x00CE, FontGlyph(6, 18, 0, -1, 0, &_FONT_WEATHER_FRAME_DATA[1728]) }, // 'Î'
-        { 0x00CF, FontGlyph(6, 17, 1, -1, 0, &_FONT_WEATHER_FRAME_DATA[1755]) }, // 'Ï'
-        { 0x00D0, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[1781]) }, // 'Ð'
-        { 0x00D1, FontGlyph(9, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1809]) }, // 'Ñ'
-        { 0x00D2, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1848]) }, // 'Ò'
-        { 0x00D3, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1884]) }, // 'Ó'
-        { 0x00D4, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[1920]) }, // 'Ô'
-        { 0x00D5, FontGlyph(8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1956]) }, // 'Õ'
-        { 0x00D6, FontGlyph(8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[1990]) }, // 'Ö'
-        { 0x00D8, FontGlyph(8, 16, 3, 0, 0, &_FONT_WEATHER_FRAME_DATA[2024]) }, // 'Ø'
-        { 0x00D9, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2056]) }, // 'Ù'
-        { 0x00DA, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2092]) }, // 'Ú'
-        { 0x00DB, FontGlyph(8, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2128]) }, // 'Û'
-        { 0x00DC, FontGlyph(8, 17, 1, 0, 0, &_FONT_WEATHER_FRAME_DATA[2164]) }, // 'Ü'
-        { 0x00DD, FontGlyph(9, 18, 0, 0, 0, &_FONT_WEATHER_FRAME_DATA[2198]) }, // 'Ý'
-        { 0x00DE, FontGlyph(8, 14, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[2239]) }, // 'Þ'
-        { 0x00DF, FontGlyph(8, 15, 4, 0, 0, &_FONT_WEATHER_FRAME_DATA[2267]) }, // 'ß'
-        { 0xFFFD, FontGlyph(4, 1, 17, 0, 2, &_FONT_WEATHER_FRAME_DATA[2297]) }, // '�'
-    },
+    .glyphs=_FONT_WEATHER_FRAME_GLYPHS,
+    .glyphCount=sizeof(_FONT_WEATHER_FRAME_GLYPHS) / sizeof(FontGlyph),
     .fgColor=0b00,
     .bgColor=0b11,
     .ascent=17,
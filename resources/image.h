@@ -2,7 +2,7 @@
 #define PORTALCALENDAR_IMAGE_H
 
 struct Image {
-    Image(uint16_t width, uint16_t height, uint8_t rleBits, const uint8_t *data):
+    constexpr Image(uint16_t width, uint16_t height, uint8_t rleBits, const uint8_t *data):
         width(width),
         height(height),
         rleBits(rleBits),
@@ -34,6 +34,19 @@ private:
         return x;
     }
 
+    /**
+     * Reads the color and length of the next run. run is the number of pixels left in the current run.
+     */
+    void readRun()
+    {
+        color = read();
+        run = 0;
+        for (uint8_t i = image.rleBits; i >= 2; i -= 2) {
+            run |= read() << (i - 2);
+        }
+        ++run;
+    }
+
 public:
     ImageReader(const Image &image): image(image), byte(0), crumb(0), run(0)
     { }
@@ -41,15 +54,34 @@ public:
     uint8_t next()
     {
         if (run == 0) {
-            color = read();
-            for (uint8_t i = image.rleBits; i >= 2; i -= 2) {
-                run |= read() << (i - 2);
-            }
-        } else {
-            --run;
+            readRun();
         }
+        --run;
         return color;
     }
+
+    /**
+     * Reads up to maxLength pixels of the current run at once, returning how many were read and storing their color in runColor.
+     * Whatever is left of the run past maxLength is returned by the next call.
+     */
+    uint16_t nextRun(uint8_t &runColor, uint16_t maxLength)
+    {
+        if (run == 0) {
+            readRun();
+        }
+        const uint16_t length = run < maxLength ? run : maxLength;
+        run -= length;
+        runColor = color;
+        return length;
+    }
+
+    void skip(size_t count)
+    {
+        uint8_t color;
+        while (count > 0) {
+            count -= nextRun(color, count < UINT16_MAX ? count : UINT16_MAX);
+        }
+    }
 };
 
 #endif // PORTALCALENDAR_IMAGE_H
@@ -1,9 +1,13 @@
+#ifndef NATIVE
 #include <ArduinoJson.h>
 #include <HTTPClient.h>
+#endif
 #include <math.h>
 #include <time.h>
+#include <vector>
 #include "Configuration.h"
 #include "time_util.h"
+#include "profiler.h"
 
 #define NTP_PACKET_SIZE 48
 #define MIN_CORRECTABLE_SLEEP_DURATION 30
@@ -106,19 +110,45 @@ void advanceDay(int& month, int& mday, int& year)
     }
 }
 
-TimezonedResult getPosixTz(std::initializer_list<const String> servers, const String name, String &result)
+#ifndef NATIVE
+/**
+ * Splits an optional :port off the end of a server name, and returns the port or defaultPort if there isn't one
+ */
+static uint16_t splitServerPort(String &host, uint16_t defaultPort)
+{
+    const int colon = host.lastIndexOf(':');
+    if (colon == -1) {
+        return defaultPort;
+    }
+    const long port = host.substring(colon + 1).toInt();
+    if (port <= 0 || port > UINT16_MAX) {
+        return defaultPort;
+    }
+    host.remove(colon);
+    return port;
+}
+
+TimezonedResult getPosixTz(std::initializer_list<const String> servers, const String name, String &result, uint32_t timeoutMs)
 {
+    ProfilePhase phase(WakePhase::TZ_LOOKUP);
+    const unsigned long start = millis();
     uint16_t i = 0;
     for (String server : servers) {
         if (server.isEmpty()) {
             continue;
         }
+        if (millis() - start >= timeoutMs) {
+            log_w("Out of time to look up the timezone from %s", server.c_str());
+            break;
+        }
         log_i("Looking up POSIX timezone for %s from %s", name.c_str(), server.c_str());
 
+        String host = server;
+        const uint16_t port = splitServerPort(host, TIMEZONED_SERVER_PORT);
         WiFiUDP udp;
         udp.flush();
         if (!udp.begin(TIMEZONED_LOCAL_PORT_START + i++) // Each server must be called on a different port in case a packet comes in late
-            || !udp.beginPacket(server.c_str(), 2342)
+            || !udp.beginPacket(host.c_str(), port)
         ) {
             udp.stop();
             continue;
@@ -135,7 +165,7 @@ TimezonedResult getPosixTz(std::initializer_list<const String> servers, const St
         do {
             yield();
             parsedPacket = udp.parsePacket();
-        } while (!parsedPacket && millis() - started < TZ_LOOKUP_TIMEOUT_MS);
+        } while (!parsedPacket && millis() - started < TZ_LOOKUP_TIMEOUT_MS && millis() - start < timeoutMs);
 
         if (!parsedPacket) {
             log_e("Timeout for server %s", server.c_str());
@@ -155,29 +185,80 @@ TimezonedResult getPosixTz(std::initializer_list<const String> servers, const St
         if (recv.startsWith("OK ")) {
             result = recv.substring(recv.indexOf(" ", 4) + 1);
             return TimezonedResult::Ok;
-        } else if (result.startsWith("ERR ")) {
+        } else if (recv.startsWith("ERR ")) {
             return TimezonedResult::TzNotFound;
         }
     }
     return TimezonedResult::ServerError;
 }
 
+/**
+ * Microseconds since the unix epoch
+ */
+static int64_t getTimeMicros()
+{
+    timeval now;
+    gettimeofday(&now, nullptr);
+    return (int64_t)now.tv_sec * uS_PER_S + now.tv_usec;
+}
+
+/**
+ * Reads a 64 bit NTP timestamp from a packet as microseconds since the unix epoch
+ */
+static int64_t readNtpTimestamp(const byte *data)
+{
+    uint32_t seconds = data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
+    uint32_t fraction = data[4] << 24 | data[5] << 16 | data[6] << 8 | data[7];
+    // Subtract 70 years to get seconds since 1970
+    return ((int64_t)seconds - 2208988800LL) * uS_PER_S + (((uint64_t)fraction * uS_PER_S) >> 32);
+}
+
+static void writeNtpTimestamp(byte *data, int64_t micros)
+{
+    uint32_t seconds = micros / uS_PER_S + 2208988800LL;
+    uint32_t fraction = ((uint64_t)(micros % uS_PER_S) << 32) / uS_PER_S;
+    for (int i = 0; i < 4; ++i) {
+        data[i] = seconds >> (24 - i * 8);
+        data[i + 4] = fraction >> (24 - i * 8);
+    }
+}
+
+struct NtpRequest
+{
+    String server;
+    WiFiUDP udp;
+    /**
+     * Local time the request was sent, which the server echoes back as the origin timestamp
+     */
+    int64_t sentAt;
+    bool waiting;
+};
+
 /**
  * Based on the queryNTP function from ezTime
  * https://github.com/ropg/ezTime
  *
  * @return True if the NTP sync was successful
  */
-bool syncNtp(std::initializer_list<const String> servers, bool test)
+bool syncNtp(std::initializer_list<const String> servers, bool test, uint32_t timeoutMs)
 {
+    ProfilePhase phase(WakePhase::NTP_SYNC);
+    const unsigned long started = millis();
+
+    // Send a request to every server at once, each from a different port so replies can't be mixed up
+    std::vector<NtpRequest> requests(servers.size());
     uint16_t i = 0;
+    size_t waiting = 0;
     for (String server : servers) {
+        NtpRequest &request = requests[i];
+        request.server = server;
+        request.waiting = false;
         if (server.isEmpty()) {
+            ++i;
             continue;
         }
         log_i("Starting NTP request to %s", server.c_str());
 
-        // Send NTP packet
         byte buffer[NTP_PACKET_SIZE];
         memset(buffer, 0, NTP_PACKET_SIZE);
         buffer[0] = 0b11100011;     // LI, Version, Mode
@@ -190,93 +271,119 @@ bool syncNtp(std::initializer_list<const String> servers, bool test)
         buffer[14]  = 'Z';
         buffer[15]  = 'T';
 
-        WiFiUDP udp;
-        udp.flush();
-        if (!udp.begin(NTP_LOCAL_PORT_START + i++) // Each server must be called on a different port in case a packet comes in late
-            || !udp.beginPacket(server.c_str(), 123)
-        ) {
-            udp.stop();
+        String host = server;
+        const uint16_t port = splitServerPort(host, NTP_SERVER_PORT);
+        if (!request.udp.begin(NTP_LOCAL_PORT_START + i++) || !request.udp.beginPacket(host.c_str(), port)) {
+            request.udp.stop();
             continue;
         }
-        unsigned long started = millis();
-        udp.write(buffer, NTP_PACKET_SIZE);
-        if (!udp.endPacket()) {
-            udp.stop();
+        request.sentAt = getTimeMicros();
+        writeNtpTimestamp(&buffer[40], request.sentAt);
+        request.udp.write(buffer, NTP_PACKET_SIZE);
+        if (!request.udp.endPacket()) {
+            request.udp.stop();
             continue;
         }
+        request.waiting = true;
+        ++waiting;
+    }
 
-        // Wait for packet until timeout
-        int parsedPacket;
-        do {
-            yield();
-            parsedPacket = udp.parsePacket();
-        } while (!parsedPacket && millis() - started < NTP_TIMEOUT_MS);
-
-        if (!parsedPacket) {
-            log_e("NTP sync timeout for server %s", server.c_str());
-            udp.stop();
-            continue;
-        }
-        udp.read(buffer, NTP_PACKET_SIZE);
-        udp.stop();
+    // Collect replies until every server has answered, NTP_TIMEOUT_MS (or timeoutMs) passes without any valid reply, or
+    // NTP_COLLECT_WINDOW_MS passes after the first one
+    bool haveSample = false;
+    unsigned long firstReplyAt = 0;
+    int64_t bestOffset = 0, bestDelay = 0;
+    const char* bestServer = nullptr;
+    const uint32_t timeout = min((uint32_t)NTP_TIMEOUT_MS, timeoutMs);
+    while (waiting
+        && millis() - started < timeout
+        && (!haveSample || millis() - firstReplyAt < NTP_COLLECT_WINDOW_MS)
+    ) {
+        yield();
+        for (NtpRequest &request : requests) {
+            if (!request.waiting || !request.udp.parsePacket()) {
+                continue;
+            }
+            const int64_t receivedAt = getTimeMicros();
+            byte buffer[NTP_PACKET_SIZE];
+            const int length = request.udp.read(buffer, NTP_PACKET_SIZE);
+            request.udp.stop();
+            request.waiting = false;
+            --waiting;
 
-        //prepare timestamps
-        uint32_t highWord, lowWord;
-        highWord = ( buffer[16] << 8 | buffer[17] ) & 0x0000FFFF;
-        lowWord = ( buffer[18] << 8 | buffer[19] ) & 0x0000FFFF;
-        uint32_t reftsSec = highWord << 16 | lowWord;				// reference timestamp seconds
-
-        highWord = ( buffer[32] << 8 | buffer[33] ) & 0x0000FFFF;
-        lowWord = ( buffer[34] << 8 | buffer[35] ) & 0x0000FFFF;
-        uint32_t rcvtsSec = highWord << 16 | lowWord;				// receive timestamp seconds
-
-        highWord = ( buffer[40] << 8 | buffer[41] ) & 0x0000FFFF;
-        lowWord = ( buffer[42] << 8 | buffer[43] ) & 0x0000FFFF;
-        uint32_t secsSince1900 = highWord << 16 | lowWord;			// transmit timestamp seconds
-
-        highWord = ( buffer[44] << 8 | buffer[45] ) & 0x0000FFFF;
-        lowWord = ( buffer[46] << 8 | buffer[47] ) & 0x0000FFFF;
-        uint32_t fraction = highWord << 16 | lowWord;				// transmit timestamp fractions	
-
-        //check if received data makes sense
-        //buffer[1] = stratum - should be 1..15 for valid reply
-        //also checking that all timestamps are non-zero and receive timestamp seconds are <= transmit timestamp seconds
-        if ((buffer[1] < 1) or (buffer[1] > 15) or (reftsSec == 0) or (rcvtsSec == 0) or (rcvtsSec > secsSince1900)) {
-            // we got invalid packet
-            log_e("NTP sync failed for server %s", server.c_str());
-            continue;
-        }
+            // Check the reply makes sense: the stratum should be 1..15, the reference, receive and transmit timestamps
+            // should be set and in order, and the origin timestamp should be the one we sent
+            uint32_t refSeconds = buffer[16] << 24 | buffer[17] << 16 | buffer[18] << 8 | buffer[19];
+            byte origin[8];
+            writeNtpTimestamp(origin, request.sentAt);
+            const int64_t serverReceivedAt = readNtpTimestamp(&buffer[32]);
+            const int64_t serverSentAt = readNtpTimestamp(&buffer[40]);
+            if (length != NTP_PACKET_SIZE
+                || buffer[1] < 1
+                || buffer[1] > 15
+                || refSeconds == 0
+                || memcmp(&buffer[24], origin, sizeof(origin)) != 0
+                || serverReceivedAt > serverSentAt
+            ) {
+                log_e("NTP sync failed for server %s", request.server.c_str());
+                continue;
+            }
 
-        // Set the t and measured_at variables that were passed by reference
-        unsigned long duration = millis() - started;
-        log_i("NTP sync took %lums", duration);
-        if (test) {
-            return true;
+            // RFC 5905 on-wire calculation, from the client send (t1), server receive (t2), server send (t3) and
+            // client receive (t4) timestamps
+            const int64_t offset = ((serverReceivedAt - request.sentAt) + (serverSentAt - receivedAt)) / 2;
+            const int64_t delay = (receivedAt - request.sentAt) - (serverSentAt - serverReceivedAt);
+            log_i("NTP reply from %s: offset %lldus, round trip %lldus", request.server.c_str(), offset, delay);
+            if (!haveSample || delay < bestDelay) {
+                bestOffset = offset;
+                bestDelay = delay;
+                bestServer = request.server.c_str();
+            }
+            if (!haveSample) {
+                haveSample = true;
+                firstReplyAt = millis();
+            }
         }
-        suseconds_t us = (fraction / 4294967UL + duration / 2) * 1000; // Assume symmetric network latency
-        timeval now = {
-            .tv_sec = (time_t)(secsSince1900 - 2208988800UL) + us / uS_PER_S, // Subtract 70 years to get seconds since 1970
-            .tv_usec = us % uS_PER_S,
-        };
-        timeval oldNow;
-        gettimeofday(&oldNow, nullptr);
-        settimeofday(&now, nullptr);
-        log_i("Time after NTP sync is %s", printTime(now.tv_sec));
-        float maxRtcCorrectionFactor = Config.getMaxRtcCorrectionFactor();
-        long driftMs = (now.tv_sec - oldNow.tv_sec) * 1000 + (now.tv_usec - oldNow.tv_usec) / 1000;
-        if (!maxRtcCorrectionFactor) {
-            rtcCorrectionFactor = 0;
-            log_i("System clock drift was %ldms", driftMs);
-        } else if (lastNtpSync && difftime(now.tv_sec, lastNtpSync) > 30) {
-            rtcCorrectionFactor -= (float)driftMs / 1000.0 / difftime(now.tv_sec, lastNtpSync);
-            rtcCorrectionFactor = clamp(rtcCorrectionFactor, maxRtcCorrectionFactor);
-            log_i("System clock drift was %ldms, new correction factor is %0.4f", driftMs, rtcCorrectionFactor);
+    }
+    for (NtpRequest &request : requests) {
+        if (request.waiting) {
+            log_e("NTP sync timeout for server %s", request.server.c_str());
+            request.udp.stop();
         }
-        lastNtpSync = now.tv_sec;
+    }
+
+    log_i("NTP sync took %lums", millis() - started);
+    if (!haveSample) {
+        return false;
+    }
+    log_i("Using NTP reply from %s", bestServer);
+    if (test) {
         return true;
     }
-    return false;
+
+    // Apply the offset to the current time rather than the time the reply arrived, so later replies we waited for
+    // don't make it stale
+    const int64_t newTime = getTimeMicros() + bestOffset;
+    timeval now = {
+        .tv_sec = (time_t)(newTime / uS_PER_S),
+        .tv_usec = (suseconds_t)(newTime % uS_PER_S),
+    };
+    settimeofday(&now, nullptr);
+    log_i("Time after NTP sync is %s", printTime(now.tv_sec));
+    float maxRtcCorrectionFactor = Config.getMaxRtcCorrectionFactor();
+    long driftMs = bestOffset / 1000;
+    if (!maxRtcCorrectionFactor) {
+        rtcCorrectionFactor = 0;
+        log_i("System clock drift was %ldms", driftMs);
+    } else if (lastNtpSync && difftime(now.tv_sec, lastNtpSync) > 30) {
+        rtcCorrectionFactor -= (float)driftMs / 1000.0 / difftime(now.tv_sec, lastNtpSync);
+        rtcCorrectionFactor = clamp(rtcCorrectionFactor, maxRtcCorrectionFactor);
+        log_i("System clock drift was %ldms, new correction factor is %0.4f", driftMs, rtcCorrectionFactor);
+    }
+    lastNtpSync = now.tv_sec;
+    return true;
 }
+#endif // NATIVE
 
 #if CORE_DEBUG_LEVEL > 0
 char timeStr[30];
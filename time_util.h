@@ -52,16 +52,26 @@ enum class TimezonedResult : uint8_t {
  * although I decided using the entirety of ezTime wasn't ideal.
  * 
  * This can also lookup timezone by IP address by passing "GeoIP", however I've found that pretty unreliable for where I live.
+ *
+ * Servers are tried one after another, and the lookup gives up once timeoutMs has passed.
  */
-TimezonedResult getPosixTz(std::initializer_list<const String> servers, const String name, String &result);
+TimezonedResult getPosixTz(
+    std::initializer_list<const String> servers,
+    const String name,
+    String &result,
+    uint32_t timeoutMs = UINT32_MAX
+);
 
 /**
  * Based on the queryNTP function from ezTime
  * https://github.com/ropg/ezTime
  *
+ * Queries all servers at the same time and sets the clock from the reply with the shortest round trip. Gives up once
+ * NTP_TIMEOUT_MS or timeoutMs has passed, whichever is sooner.
+ *
  * @return True if the NTP sync was successful
  */
-bool syncNtp(std::initializer_list<const String> servers, bool test = false);
+bool syncNtp(std::initializer_list<const String> servers, bool test = false, uint32_t timeoutMs = UINT32_MAX);
 
 #if CORE_DEBUG_LEVEL > 0
 const char* printTime(time_t t);
@@ -1,9 +1,15 @@
+#ifndef NATIVE
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#endif
+#include <esp_rom_crc.h>
 #include "weather.h"
 #include "global.h"
 #include "Configuration.h"
 #include "time_util.h"
+#include "profiler.h"
+
+#define WEATHER_READ_BUFFER_SIZE 256
 
 const WeatherEntry EMPTY_WEATHER_ENTRY = {
     .condition = WeatherCondition::UNKNOWN,
@@ -29,21 +35,86 @@ const DailyWeather EMPTY_DAILY_WEATHER = {
     .wday = -1,
 };
 
+#define PACKED_WEATHER_EMPTY 0xF
+#define OWM_FORECAST_INTERVAL (3 * SECONDS_PER_HOUR)
+
+const PackedWeatherEntry EMPTY_PACKED_WEATHER_ENTRY = {
+    .condition = PACKED_WEATHER_EMPTY,
+    .temp = 0,
+    .clouds = 0,
+    .pop = 0,
+    .humidity = 0,
+};
+
 RTC_DATA_ATTR time_t lastWeatherSync = 0;
 RTC_DATA_ATTR time_t sunriseTime = 0;
 RTC_DATA_ATTR time_t sunsetTime = 0;
-#define WEATHER_ENTRY_COUNT 40
-RTC_DATA_ATTR WeatherEntry weatherEntries[WEATHER_ENTRY_COUNT] = {
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
-    EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY, EMPTY_WEATHER_ENTRY,
+RTC_DATA_ATTR time_t weatherStartTime = 0;
+RTC_DATA_ATTR int16_t weatherBaseTemp = 0;
+RTC_DATA_ATTR PackedWeatherEntry weatherEntries[WEATHER_ENTRY_COUNT] = {
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+    EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY, EMPTY_PACKED_WEATHER_ENTRY,
+};
+
+/**
+ * 40 entries 3 hours apart can touch 6 calendar days, plus one for a day made longer by a DST change
+ */
+#define WEATHER_DAY_COUNT (WEATHER_ENTRY_COUNT * OWM_FORECAST_INTERVAL / SECONDS_PER_DAY + 2)
+
+/**
+ * The range of weather entries on one calendar day, in local time
+ */
+struct WeatherDay
+{
+    int8_t month;
+    int8_t mday;
+    int8_t wday;
+    uint8_t first;
+    uint8_t last;
+    /**
+     * Local minute of the day of the first entry
+     */
+    int16_t firstMinute;
+};
+
+/**
+ * Which entries fall on which day, so lookups don't have to work out the local time of every entry. Built when the
+ * forecast is parsed, and again if the timezone has changed since.
+ */
+struct WeatherDayIndex
+{
+    uint32_t timezoneCrc;
+    uint8_t count;
+    WeatherDay days[WEATHER_DAY_COUNT];
 };
 
+RTC_DATA_ATTR WeatherDayIndex weatherDays = {};
+
+/**
+ * The 5 day forecast for each day in weatherDays, so renders don't have to work it out from the entries. Built along
+ * with the index, and again if the weather start hour changes. Changing the units isn't handled here since the entries
+ * are in the units they were downloaded in. Saving the settings forces a weather sync, which downloads them again.
+ */
+struct DailyWeatherCache
+{
+    int8_t startHour;
+    DailyWeather days[WEATHER_DAY_COUNT];
+};
+
+RTC_DATA_ATTR DailyWeatherCache dailyWeather = {
+    .startHour = -1,
+    .days = {},
+};
+
+#ifndef NATIVE
 String urlEncode(String str)
 {
     const char* hex = "0123456789ABCDEF";
@@ -62,6 +133,7 @@ String urlEncode(String str)
     }
     return result;
 }
+#endif // NATIVE
 
 bool isDaylight(time_t t)
 {
@@ -122,130 +194,512 @@ WeatherCondition parseOWMWeatherConditionId(int id)
     }
 }
 
-void parseOWMWeatherEntry(const JsonVariant& data, WeatherEntry& entry)
+WeatherEntry getWeatherEntry(int i)
 {
-    time_t time = data["dt"].as<time_t>();
+    const PackedWeatherEntry &packed = weatherEntries[i];
+    if (packed.condition == PACKED_WEATHER_EMPTY) {
+        return EMPTY_WEATHER_ENTRY;
+    }
+
+    const time_t time = weatherStartTime + i * OWM_FORECAST_INTERVAL;
     tm localtime;
     localtime_r(&time, &localtime);
 
-    entry.condition = parseOWMWeatherConditionId(data["weather"][0]["id"].as<int>());
-    entry.temp = (int16_t)round(data["main"]["temp"].as<float>());
-    entry.daylight = isDaylight(time);
-    entry.clouds = data["clouds"]["all"].as<uint8_t>();
-    entry.pop = (uint8_t)round(data["pop"].as<float>() * 100.0);
-    entry.humidity = data["main"]["humidity"].as<uint8_t>();
-    entry.month = localtime.tm_mon;
-    entry.mday = localtime.tm_mday;
-    entry.wday = localtime.tm_wday;
-    entry.hour = localtime.tm_hour;
-    entry.minute = localtime.tm_min;
+    return {
+        .condition = static_cast<WeatherCondition>(packed.condition),
+        .temp = (int16_t)(weatherBaseTemp + packed.temp),
+        .daylight = isDaylight(time),
+        .clouds = (int8_t)packed.clouds,
+        .pop = (int8_t)packed.pop,
+        .humidity = (int8_t)packed.humidity,
+        .month = (int8_t)localtime.tm_mon,
+        .mday = (int8_t)localtime.tm_mday,
+        .wday = (int8_t)localtime.tm_wday,
+        .hour = (int8_t)localtime.tm_hour,
+        .minute = (int8_t)localtime.tm_min,
+    };
+}
+
+static uint32_t getTimezoneCrc()
+{
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t*>(savedTimezone), strlen(savedTimezone));
 }
 
 /**
- * Gets the index of the weather entry closest to the specified hour on the specified day.
- * Returns -1 if no entries exist for the specified day.
+ * Gets the index of the weather entry closest to the specified hour on the specified day
  */
-int findWeatherEntry(int month, int mday, int hour, int startIndex = 0)
+int findWeatherEntry(const WeatherDay &day, int hour)
+{
+    // Reach the closest entry to the target hour. Since OWM returns data in 3 hour intervals, the closest entry will be
+    // at most 90 minutes off. However this also needs to consider the closest entry being far ahead of the target hour,
+    // since OWM doesn't return past data and it could have been fetched at any time. Entries are assumed to be evenly
+    // spaced through the day, which can put this an entry off on the days DST starts or ends.
+    const int interval = OWM_FORECAST_INTERVAL / 60;
+    const int offset = hour * 60 - 90 - day.firstMinute;
+    const int i = day.first + max(0, (offset + interval - 1) / interval);
+    // Hour is greater than any hour returned by OWM for this day, so return the last entry
+    return min(i, (int)day.last);
+}
+
+void buildDailyWeather()
 {
-    const int minuteOfDay = hour * 60;
-    WeatherEntry *current;
-    bool foundDay = false;
-    for (int i = max(startIndex, 0); i < WEATHER_ENTRY_COUNT; ++i) {
-        current = &weatherEntries[i];
-        if (current->month == month && current->mday == mday) {
-            foundDay = true;
-            // Reach the closest entry to the target hour. Since OWM returns data in 3 hour intervals, the closest
-            // entry will be at most 90 minutes off. However this also needs to consider the closest entry being far
-            // ahead of the target hour, since OWM doesn't return past data and it could have been fetched at any time.
-            if (current->hour >= hour || abs((int)current->hour * 60 + (int)current->minute - minuteOfDay) <= 90) {
-                return i;
+    const int startHour = Config.getWeatherStartHour();
+    dailyWeather.startHour = startHour;
+
+    for (uint8_t i = 0; i < weatherDays.count; ++i) {
+        const WeatherDay &entries = weatherDays.days[i];
+        DailyWeather &day = dailyWeather.days[i];
+        day = EMPTY_DAILY_WEATHER;
+        day.month = entries.month;
+        day.mday = entries.mday;
+        day.wday = entries.wday;
+
+        float clouds = 0.0, daylight = 0.0;
+        int sampleCount = 0;
+        const int conditionStart = findWeatherEntry(entries, startHour);
+        const int conditionEnd = conditionStart + 4;
+
+        for (int j = entries.first; j <= entries.last; ++j) {
+            const PackedWeatherEntry &entry = weatherEntries[j];
+            if (entry.condition == PACKED_WEATHER_EMPTY) {
+                continue;
             }
-        } else if (foundDay) {
-            // Hour is greater than any hour returned by OWM for this day, so return the last entry
-            return i - 1;
+            // Calculate high/low temp for entire 24-hour day
+            const int16_t temp = weatherBaseTemp + entry.temp;
+            day.highTemp = max(day.highTemp, temp);
+            day.lowTemp = min(day.lowTemp, temp);
+            // Calculate overall condition only for the 12 hour period after the start hour
+            if (j >= conditionStart && j <= conditionEnd) {
+                ++sampleCount;
+                day.condition = max(day.condition, static_cast<WeatherCondition>(entry.condition));
+                clouds = (clouds * (sampleCount - 1) + (float)entry.clouds) / sampleCount;
+                const bool isDay = isDaylight(weatherStartTime + j * OWM_FORECAST_INTERVAL);
+                daylight = (daylight * (sampleCount - 1) + (isDay ? 100.0 : 0.0)) / sampleCount;
+            }
+        }
+
+        log_i("Found %d weather condition samples for %d/%d", sampleCount, day.month + 1, day.mday);
+        day.daylight = daylight >= 50.0;
+        if (day.condition != WeatherCondition::UNKNOWN && day.condition <= WeatherCondition::OVERCAST_CLOUDS) {
+            // Use average daily cloud cover for a more representative weather icon
+            day.condition = getWeatherConditionByCloudCover((int)clouds);
+        }
+    }
+}
+
+void buildWeatherDayIndex()
+{
+    weatherDays = {
+        .timezoneCrc = getTimezoneCrc(),
+        .count = 0,
+        .days = {},
+    };
+    WeatherDay *day = nullptr;
+    for (int i = 0; i < WEATHER_ENTRY_COUNT; ++i) {
+        if (weatherEntries[i].condition == PACKED_WEATHER_EMPTY) {
+            continue;
+        }
+        const time_t time = weatherStartTime + i * OWM_FORECAST_INTERVAL;
+        tm localtime;
+        localtime_r(&time, &localtime);
+        if (day && day->month == localtime.tm_mon && day->mday == localtime.tm_mday) {
+            day->last = i;
+            continue;
+        }
+        if (weatherDays.count == WEATHER_DAY_COUNT) {
+            break;
+        }
+        day = &weatherDays.days[weatherDays.count++];
+        *day = {
+            .month = (int8_t)localtime.tm_mon,
+            .mday = (int8_t)localtime.tm_mday,
+            .wday = (int8_t)localtime.tm_wday,
+            .first = (uint8_t)i,
+            .last = (uint8_t)i,
+            .firstMinute = (int16_t)(localtime.tm_hour * 60 + localtime.tm_min),
+        };
+    }
+    buildDailyWeather();
+}
+
+/**
+ * Gets the position of the specified day in weatherDays, or -1 if there aren't any entries for it
+ */
+int8_t findWeatherDay(int month, int mday)
+{
+    if (weatherDays.timezoneCrc != getTimezoneCrc()) {
+        buildWeatherDayIndex();
+    }
+    for (uint8_t i = 0; i < weatherDays.count; ++i) {
+        if (weatherDays.days[i].month == month && weatherDays.days[i].mday == mday) {
+            return i;
         }
     }
     log_w("Failed to find weather entry for %d/%d", month + 1, mday);
     return -1;
 }
 
-void getTodaysWeather(int month, int mday, WeatherEntry (&result)[5])
+ForecastParser::ForecastParser() :
+    _state(State::VALUE),
+    _isKey(false),
+    _overflow(false),
+    _unicodeDigits(0),
+    _depth(0),
+    _scratchLength(0),
+    _entryCount(0),
+    _haveBaseTemp(false),
+    _baseTemp(0),
+    _sunrise(0),
+    _sunset(0)
 {
-    int i = findWeatherEntry(month, mday, Config.getWeatherStartHour());
-    int j = 0;
-    if (i != -1) {
-        for (; j < 5 && i + j < WEATHER_ENTRY_COUNT; ++j) {
-            result[j] = weatherEntries[i + j];
-        }
+}
+
+void ForecastParser::parse(const char *data, size_t length)
+{
+    for (size_t i = 0; i < length && _state != State::ERROR; ++i) {
+        parseChar(data[i]);
     }
-    log_i("Found %d weather entries for %d/%d", j, month + 1, mday);
-    for (; j < 5; ++j) {
-        result[j] = EMPTY_WEATHER_ENTRY;
+}
+
+bool ForecastParser::finish()
+{
+    if (_state != State::DONE) {
+        // Keep showing the last forecast rather than none at all
+        log_e("Forecast response was %s", _state == State::ERROR ? "malformed" : "incomplete");
+        return false;
+    }
+    if (!_entryCount) {
+        log_e("Forecast response had no entries");
+        return false;
+    }
+
+    // Entries are stored by their time, so if OWM ever skips one the rest still end up where they belong, and in case
+    // it returned less results than expected the rest are cleared
+    const time_t start = _times[0];
+    for (size_t i = 0; i < WEATHER_ENTRY_COUNT; ++i) {
+        weatherEntries[i] = EMPTY_PACKED_WEATHER_ENTRY;
     }
+    for (size_t i = 0; i < _entryCount; ++i) {
+        const long slot = (_times[i] - start + OWM_FORECAST_INTERVAL / 2) / OWM_FORECAST_INTERVAL;
+        if (slot >= 0 && slot < WEATHER_ENTRY_COUNT) {
+            weatherEntries[slot] = _entries[i];
+        }
+    }
+
+    weatherStartTime = start;
+    weatherBaseTemp = _baseTemp;
+    sunriseTime = _sunrise;
+    sunsetTime = _sunset;
+    buildWeatherDayIndex();
+    return true;
 }
 
-void get5DayWeather(int month, int mday, int year, DailyWeather (&result)[5])
+void ForecastParser::parseChar(char c)
 {
-    DailyWeather *day;
-    WeatherEntry *entry;
-    int j = 0;
-    int conditionStart, conditionEnd;
-    float clouds, daylight;
-    int sampleCount;
+    switch (_state) {
+        case State::STRING:
+            if (c == '"') {
+                if (_isKey) {
+                    endKey();
+                } else {
+                    endValue();
+                }
+            } else if (c == '\\') {
+                _state = State::STRING_ESCAPE;
+            } else if (_isKey) {
+                appendScratch(c);
+            }
+            return;
+        case State::STRING_ESCAPE:
+            if (c == 'u') {
+                _unicodeDigits = 0;
+                _state = State::STRING_UNICODE;
+            } else {
+                // None of the keys we look for have escapes in them, so the exact character doesn't matter
+                appendScratch(c);
+                _state = State::STRING;
+            }
+            return;
+        case State::STRING_UNICODE:
+            if (!isxdigit(c)) {
+                _state = State::ERROR;
+            } else if (++_unicodeDigits == 4) {
+                appendScratch('?');
+                _state = State::STRING;
+            }
+            return;
+        case State::LITERAL:
+            if (isalnum(c) || c == '.' || c == '-' || c == '+') {
+                appendScratch(c);
+                return;
+            }
+            endNumber();
+            endValue();
+            // The character after a literal is the start of whatever comes next
+            break;
+        default:
+            break;
+    }
 
-    for (int i = 0; i < 5; ++i) {
-        day = &result[i];
-        *day = EMPTY_DAILY_WEATHER;
+    if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+        return;
+    }
 
-        j = findWeatherEntry(month, mday, 0, j);
-        if (j == -1) {
-            j = 0;
-            advanceDay(month, mday, year);
-            continue;
+    switch (_state) {
+        case State::VALUE_OR_END:
+            if (c == ']') {
+                if (pop(true)) {
+                    endValue();
+                }
+                return;
+            }
+            // fall through
+        case State::VALUE:
+            if (c == '{') {
+                push(false);
+            } else if (c == '[') {
+                push(true);
+            } else if (c == '"') {
+                _isKey = false;
+                _state = State::STRING;
+            } else if (c == '-' || isalnum(c)) {
+                _overflow = false;
+                _scratchLength = 0;
+                appendScratch(c);
+                _state = State::LITERAL;
+            } else {
+                _state = State::ERROR;
+            }
+            return;
+        case State::KEY_OR_END:
+            if (c == '}') {
+                if (pop(false)) {
+                    endValue();
+                }
+                return;
+            }
+            // fall through
+        case State::KEY:
+            if (c == '"') {
+                _isKey = true;
+                _overflow = false;
+                _scratchLength = 0;
+                _state = State::STRING;
+            } else {
+                _state = State::ERROR;
+            }
+            return;
+        case State::COLON:
+            _state = c == ':' ? State::VALUE : State::ERROR;
+            return;
+        case State::AFTER_VALUE: {
+            Level &level = _stack[_depth - 1];
+            if (c == ',') {
+                if (level.array) {
+                    if (level.index < UINT8_MAX) {
+                        ++level.index;
+                    }
+                    _state = State::VALUE;
+                } else {
+                    _state = State::KEY;
+                }
+            } else if ((c == ']' || c == '}') && pop(c == ']')) {
+                endValue();
+            } else {
+                _state = State::ERROR;
+            }
+            return;
         }
+        default:
+            // Anything but whitespace after the end of the response
+            _state = State::ERROR;
+            return;
+    }
+}
 
-        day->month = month;
-        day->mday = mday;
-        day->wday = weatherEntries[j].wday;
+void ForecastParser::push(bool array)
+{
+    if (_depth == MAX_DEPTH) {
+        _state = State::ERROR;
+        return;
+    }
+    if (!array && at({ Key::LIST, Key::INDEX })) {
+        // Start of a forecast entry
+        const uint8_t i = _stack[1].index;
+        if (i < WEATHER_ENTRY_COUNT) {
+            _entries[i] = {
+                .condition = static_cast<uint32_t>(WeatherCondition::UNKNOWN),
+                .temp = 0,
+                .clouds = 0,
+                .pop = 0,
+                .humidity = 0,
+            };
+            _times[i] = 0;
+            _entryCount = max(_entryCount, (uint8_t)(i + 1));
+        }
+    }
+    _stack[_depth++] = {
+        .array = array,
+        .key = Key::OTHER,
+        .index = 0,
+    };
+    _state = array ? State::VALUE_OR_END : State::KEY_OR_END;
+}
 
-        clouds = 0.0;
-        daylight = 0.0;
-        sampleCount = 0;
+bool ForecastParser::pop(bool array)
+{
+    if (_stack[_depth - 1].array != array) {
+        _state = State::ERROR;
+        return false;
+    }
+    --_depth;
+    return true;
+}
 
-        conditionStart = findWeatherEntry(month, mday, Config.getWeatherStartHour(), j);
-        conditionEnd = conditionStart + 4;
+void ForecastParser::endValue()
+{
+    _state = _depth ? State::AFTER_VALUE : State::DONE;
+}
 
-        for (; j < WEATHER_ENTRY_COUNT; ++j) {
-            entry = &weatherEntries[j];
-            if (entry->mday != mday) {
+void ForecastParser::endKey()
+{
+    static const struct {
+        const char *name;
+        Key key;
+    } KEYS[] = {
+        { "city", Key::CITY },
+        { "sunrise", Key::SUNRISE },
+        { "sunset", Key::SUNSET },
+        { "list", Key::LIST },
+        { "dt", Key::DT },
+        { "main", Key::MAIN },
+        { "temp", Key::TEMP },
+        { "humidity", Key::HUMIDITY },
+        { "clouds", Key::CLOUDS },
+        { "all", Key::ALL },
+        { "weather", Key::WEATHER },
+        { "id", Key::ID },
+        { "pop", Key::POP },
+    };
+
+    Key &key = _stack[_depth - 1].key;
+    key = Key::OTHER;
+    if (!_overflow) {
+        _scratch[_scratchLength] = '\0';
+        for (const auto &entry : KEYS) {
+            if (!strcmp(_scratch, entry.name)) {
+                key = entry.key;
                 break;
             }
-            // Calculate high/low temp for entire 24-hour day
-            day->highTemp = max(day->highTemp, entry->temp);
-            day->lowTemp = min(day->lowTemp, entry->temp);
-            // Calculate overall condition only for the 12 hour period after the start hour
-            if (j >= conditionStart && j <= conditionEnd) {
-                ++sampleCount;
-                day->condition = max(day->condition, entry->condition);
-                clouds = (clouds * (sampleCount - 1) + (float)entry->clouds) / sampleCount;
-                daylight = (daylight * (sampleCount - 1) + (entry->daylight ? 100.0 : 0.0)) / sampleCount;
-            }
         }
+    }
+    _state = State::COLON;
+}
 
-        log_i("Found %d weather condition samples for %d/%d/%d", sampleCount, month + 1, mday, year);
-        day->daylight = daylight >= 50.0;
-        if (day->condition != WeatherCondition::UNKNOWN && day->condition <= WeatherCondition::OVERCAST_CLOUDS) {
-            // Use average daily cloud cover for a more representative weather icon
-            day->condition = getWeatherConditionByCloudCover((int)clouds);
+void ForecastParser::endNumber()
+{
+    if (_overflow || !(isdigit(_scratch[0]) || _scratch[0] == '-')) {
+        // Too long to be anything we want, or true/false/null
+        return;
+    }
+    _scratch[_scratchLength] = '\0';
+
+    if (at({ Key::CITY, Key::SUNRISE })) {
+        _sunrise = strtoll(_scratch, nullptr, 10);
+        return;
+    } else if (at({ Key::CITY, Key::SUNSET })) {
+        _sunset = strtoll(_scratch, nullptr, 10);
+        return;
+    }
+
+    // Everything else is in a forecast entry
+    if (_depth < 3 || _stack[0].key != Key::LIST || !_stack[1].array || _stack[1].index >= WEATHER_ENTRY_COUNT) {
+        return;
+    }
+    const uint8_t i = _stack[1].index;
+    PackedWeatherEntry &entry = _entries[i];
+    if (at({ Key::LIST, Key::INDEX, Key::DT })) {
+        _times[i] = strtoll(_scratch, nullptr, 10);
+    } else if (at({ Key::LIST, Key::INDEX, Key::POP })) {
+        entry.pop = min(max((int)round(strtof(_scratch, nullptr) * 100.0), 0), 100);
+    } else if (at({ Key::LIST, Key::INDEX, Key::MAIN, Key::TEMP })) {
+        const int16_t temp = (int16_t)round(strtof(_scratch, nullptr));
+        if (!_haveBaseTemp) {
+            _baseTemp = temp;
+            _haveBaseTemp = true;
         }
+        // Temperatures 5 days apart won't be more than 127 degrees apart
+        entry.temp = clamp(temp - _baseTemp, 127);
+    } else if (at({ Key::LIST, Key::INDEX, Key::MAIN, Key::HUMIDITY })) {
+        entry.humidity = min(max((int)strtol(_scratch, nullptr, 10), 0), 100);
+    } else if (at({ Key::LIST, Key::INDEX, Key::CLOUDS, Key::ALL })) {
+        entry.clouds = min(max((int)strtol(_scratch, nullptr, 10), 0), 100);
+    } else if (at({ Key::LIST, Key::INDEX, Key::WEATHER, Key::INDEX, Key::ID }) && _stack[3].index == 0) {
+        entry.condition = static_cast<uint32_t>(parseOWMWeatherConditionId(strtol(_scratch, nullptr, 10)));
+    }
+}
+
+void ForecastParser::appendScratch(char c)
+{
+    if (_scratchLength < SCRATCH_SIZE - 1) {
+        _scratch[_scratchLength++] = c;
+    } else {
+        _overflow = true;
+    }
+}
+
+/**
+ * Whether the parser is exactly at the given path
+ */
+bool ForecastParser::at(std::initializer_list<Key> path) const
+{
+    if (path.size() != _depth) {
+        return false;
+    }
+    size_t level = 0;
+    for (Key key : path) {
+        const Level &current = _stack[level++];
+        if ((current.array ? Key::INDEX : current.key) != key) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void getTodaysWeather(int month, int mday, WeatherEntry (&result)[5])
+{
+    const int8_t day = findWeatherDay(month, mday);
+    int i = day == -1 ? -1 : findWeatherEntry(weatherDays.days[day], Config.getWeatherStartHour());
+    int j = 0;
+    if (i != -1) {
+        for (; j < 5 && i + j < WEATHER_ENTRY_COUNT; ++j) {
+            result[j] = getWeatherEntry(i + j);
+        }
+    }
+    log_i("Found %d weather entries for %d/%d", j, month + 1, mday);
+    for (; j < 5; ++j) {
+        result[j] = EMPTY_WEATHER_ENTRY;
+    }
+}
+
+void get5DayWeather(int month, int mday, int year, DailyWeather (&result)[5])
+{
+    if (dailyWeather.startHour != Config.getWeatherStartHour()) {
+        buildDailyWeather();
+    }
+    for (int i = 0; i < 5; ++i) {
+        const int8_t day = findWeatherDay(month, mday);
+        result[i] = day == -1 ? EMPTY_DAILY_WEATHER : dailyWeather.days[day];
         advanceDay(month, mday, year);
     }
 }
 
+#ifndef NATIVE
 const char* WEATHER_UNIT_NAMES[] = { "imperial", "metric" };
 
-OwmResult refreshWeather()
+OwmResult refreshWeather(std::function<void(void)> onResponse, uint32_t timeoutMs)
 {
+    ProfilePhase phase(WakePhase::WEATHER_HTTP);
     float latitude = Config.getWeatherLocationLatitude();
     float longitude = Config.getWeatherLocationLongitude();
     char url[200];
@@ -253,53 +707,50 @@ OwmResult refreshWeather()
     log_i("Looking up weather for %0.6f,%0.6f from openweathermap", latitude, longitude);
     HTTPClient http;
     unsigned long start = millis();
-    http.setConnectTimeout(10000);
+    http.setConnectTimeout(min((uint32_t)10000, timeoutMs));
+    http.setTimeout(min((uint32_t)HTTPCLIENT_DEFAULT_TCP_TIMEOUT, timeoutMs));
+    // No chunked encoding, so the body can be parsed straight off the socket
+    http.useHTTP10(true);
     sprintf(
         url,
-        "http://api.openweathermap.org/data/2.5/forecast?lat=%0.6f&lon=%0.6f&units=%s&appid=%s",
+        "http://" OWM_API_HOST "/data/2.5/forecast?lat=%0.6f&lon=%0.6f&units=%s&appid=%s",
         latitude,
         longitude,
-        urlEncode(WEATHER_UNIT_NAMES[static_cast<size_t>(Config.getWeatherUnits())]),
+        urlEncode(WEATHER_UNIT_NAMES[static_cast<size_t>(Config.getWeatherUnits())]).c_str(),
         urlEncode(Config.getOwmApiKey()).c_str()
     );
     http.begin(url);
     int status = http.GET();
+    if (onResponse) {
+        onResponse();
+    }
     if (status == 200) {
-        JsonDocument filter;
-        filter["city"]["sunrise"] = true;
-        filter["city"]["sunset"] = true;
-        filter["cnt"] = true;
-        filter["list"][0]["dt"] = true;
-        filter["list"][0]["main"]["temp"] = true;
-        filter["list"][0]["main"]["humidity"] = true;
-        filter["list"][0]["clouds"]["all"] = true;
-        filter["list"][0]["weather"][0]["id"] = true;
-        filter["list"][0]["pop"] = true;
-
-        JsonDocument response;
-        DeserializationError error = deserializeJson(response, http.getStream(), DeserializationOption::Filter(filter));
+        ProfilePhase parsePhase(WakePhase::WEATHER_PARSE);
+        WiFiClient &stream = http.getStream();
+        ForecastParser parser;
+        char buffer[WEATHER_READ_BUFFER_SIZE];
+        size_t length = 0;
+        unsigned long lastRead = millis();
+        while (!parser.done() && !parser.failed()) {
+            const int available = stream.available();
+            if (available > 0) {
+                const int read = stream.read((uint8_t*)buffer, min((size_t)available, sizeof(buffer)));
+                parser.parse(buffer, read);
+                length += read;
+                lastRead = millis();
+            } else if (!stream.connected() || millis() - lastRead > stream.getTimeout() || millis() - start > timeoutMs) {
+                break;
+            } else {
+                delay(1);
+            }
+        }
         http.end();
         log_i("Request to openweathermap took %lums", millis() - start);
-        if (error) {
-            log_e("Failed to parse response: %s", error.c_str());
+        if (!parser.finish()) {
+            log_e("Failed to parse response after %u bytes", length);
             return OwmResult::MALFORMED_RESPONSE;
         }
-
-        // Get sunrise and sunet hours for this location
-        JsonVariant city = response["city"];
-        sunriseTime = city["sunrise"].as<time_t>();
-        sunsetTime = city["sunset"].as<time_t>();
-
-        const int cnt = response["cnt"].as<int>();
-        JsonVariant list = response["list"];
-        int i = 0;
-        for (; i < min(cnt, WEATHER_ENTRY_COUNT); ++i) {
-            parseOWMWeatherEntry(list[i], weatherEntries[i]);
-        }
-        // In case owm returned less results than expected, clear the rest
-        for (; i < WEATHER_ENTRY_COUNT; ++i) {
-            weatherEntries[i] = EMPTY_WEATHER_ENTRY;
-        }
+        log_i("Parsed %u forecast entries from %u bytes", parser.getEntryCount(), length);
         time(&lastWeatherSync);
         return OwmResult::SUCCESS;
     } else {
@@ -312,7 +763,7 @@ OwmResult refreshWeather()
 OwmResult testApiKey(String apiKey)
 {
     char url[200];
-    sprintf(url, "http://api.openweathermap.org/data/2.5/weather?lat=51.48&lon=0&appid=%s", urlEncode(apiKey).c_str());
+    sprintf(url, "http://" OWM_API_HOST "/data/2.5/weather?lat=51.48&lon=0&appid=%s", urlEncode(apiKey).c_str());
 
     HTTPClient http;
     http.begin(url);
@@ -336,7 +787,7 @@ OwmLocation queryLocation(String location, String apiKey)
     http.setConnectTimeout(10000);
     sprintf(
         buffer,
-        "http://api.openweathermap.org/geo/1.0/direct?q=%s&limit=1&appid=%s",
+        "http://" OWM_API_HOST "/geo/1.0/direct?q=%s&limit=1&appid=%s",
         urlEncode(location).c_str(),
         urlEncode(apiKey).c_str()
     );
@@ -404,3 +855,4 @@ OwmLocation queryLocation(String location, String apiKey)
         };
     }
 }
+#endif // NATIVE
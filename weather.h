@@ -1,3 +1,4 @@
+#include <functional>
 #include "global.h"
 
 #ifndef PORTALCALENDAR_WEATHER_H
@@ -52,8 +53,11 @@ struct DailyWeather {
     int8_t wday;
 };
 
+#define WEATHER_ENTRY_COUNT 40
+
 /**
- * Stores a single weather entry from OWM's 5-day/3-hour API
+ * Stores a single weather entry from OWM's 5-day/3-hour API. The cache keeps these packed into 5 bytes each, see
+ * PackedWeatherEntry.
  */
 struct WeatherEntry {
     WeatherCondition condition;
@@ -69,12 +73,135 @@ struct WeatherEntry {
     int8_t minute;
 };
 
+/**
+ * How a WeatherEntry is kept in RTC memory. Entries are OWM_FORECAST_INTERVAL apart starting at weatherStartTime, so
+ * the time isn't stored, and daylight is worked out from it when the entry is read. The temperature is an offset from
+ * weatherBaseTemp, which is the first entry's temperature.
+ */
+struct __attribute__((packed)) PackedWeatherEntry
+{
+    uint32_t condition : 4;     // WeatherCondition, or PACKED_WEATHER_EMPTY if there's no entry for this time
+    int32_t temp : 8;
+    uint32_t clouds : 7;
+    uint32_t pop : 7;
+    uint32_t humidity : 7;
+};
+
 extern time_t lastWeatherSync;
 
+/**
+ * Streaming parser for responses from OWM's 5-day/3-hour forecast API. Entries are packed as the response comes in, so
+ * the whole response never has to be held in memory, and only replace the weather cache once all of it has parsed.
+ */
+class ForecastParser
+{
+public:
+    ForecastParser();
+
+    /**
+     * Parses the next part of the response. The response can be split anywhere.
+     */
+    void parse(const char *data, size_t length);
+
+    /**
+     * Call once the whole response has been parsed. Replaces the cached forecast with the parsed one, along with the
+     * sunrise and sunset times. If the response was incomplete, malformed or had no entries, the cached forecast is
+     * left as it was and this returns false.
+     *
+     * This also works out which local day each entry falls on, so the timezone mustn't be changing while it runs.
+     */
+    bool finish();
+
+    /**
+     * Whether the end of the response has been reached
+     */
+    inline bool done() const { return _state == State::DONE; }
+    inline bool failed() const { return _state == State::ERROR; }
+    inline size_t getEntryCount() const { return _entryCount; }
+
+private:
+    enum class State : uint8_t
+    {
+        VALUE,
+        VALUE_OR_END,
+        KEY,
+        KEY_OR_END,
+        STRING,
+        STRING_ESCAPE,
+        STRING_UNICODE,
+        COLON,
+        LITERAL,
+        AFTER_VALUE,
+        DONE,
+        ERROR,
+    };
+
+    /**
+     * Object keys the parser cares about. INDEX stands for an array element in a path.
+     */
+    enum class Key : uint8_t
+    {
+        OTHER,
+        INDEX,
+        CITY,
+        SUNRISE,
+        SUNSET,
+        LIST,
+        DT,
+        MAIN,
+        TEMP,
+        HUMIDITY,
+        CLOUDS,
+        ALL,
+        WEATHER,
+        ID,
+        POP,
+    };
+
+    struct Level
+    {
+        bool array;
+        Key key;
+        uint8_t index;
+    };
+
+    static const size_t MAX_DEPTH = 8;
+    static const size_t SCRATCH_SIZE = 24;
+
+    void parseChar(char c);
+    void push(bool array);
+    bool pop(bool array);
+    void endValue();
+    void endKey();
+    void endNumber();
+    void appendScratch(char c);
+    bool at(std::initializer_list<Key> path) const;
+
+    State _state;
+    bool _isKey;
+    bool _overflow;
+    uint8_t _unicodeDigits;
+    uint8_t _depth;
+    uint8_t _scratchLength;
+    uint8_t _entryCount;
+    bool _haveBaseTemp;
+    int16_t _baseTemp;
+    Level _stack[MAX_DEPTH];
+    char _scratch[SCRATCH_SIZE];
+    time_t _sunrise;
+    time_t _sunset;
+    time_t _times[WEATHER_ENTRY_COUNT];
+    PackedWeatherEntry _entries[WEATHER_ENTRY_COUNT];
+};
+
 void getTodaysWeather(int month, int mday, WeatherEntry (&result)[5]);
 void get5DayWeather(int month, int mday, int year, DailyWeather (&result)[5]);
 OwmResult testApiKey(String apiKey);
 OwmLocation queryLocation(String location, String apiKey);
-OwmResult refreshWeather();
+/**
+ * Downloads the forecast. onResponse is called once the response headers have arrived, before the forecast is parsed,
+ * so timezone and NTP syncs running at the same time can be waited on there. Gives up once timeoutMs has passed.
+ */
+OwmResult refreshWeather(std::function<void(void)> onResponse = nullptr, uint32_t timeoutMs = UINT32_MAX);
 
 #endif // PORTALCALENDAR_WEATHER_H